@@ -32,22 +32,47 @@
 #include <array>
 #include "SSD1306.hpp"
 
-void SSD1306::Write_Command(uint8_t command)
+/// Converts result of HAL function to SSD1306::Error
+static int Error_Of(I2C_HandleTypeDef *conn, HAL_StatusTypeDef status)
 {
-    auto temp = HAL_I2C_Mem_Write(conn, address, control_b_command, 1, &command,
-            1, 1000);
-    if (temp != 0)
+    uint32_t error = HAL_I2C_GetError(conn);
+    if (status == HAL_TIMEOUT || (error & HAL_I2C_ERROR_TIMEOUT) != 0)
     {
-        last_error = temp;
+        return SSD1306::ERROR_TIMEOUT;
     }
+    if (status == HAL_BUSY)
+    {
+        return SSD1306::ERROR_BUSY;
+    }
+    if ((error & HAL_I2C_ERROR_AF) != 0)
+    {
+        return SSD1306::ERROR_NACK;
+    }
+    return SSD1306::ERROR_BUS;
+}
+
+bool SSD1306::Transmit(uint8_t control_byte, const uint8_t *data, uint16_t size)
+{
+    auto temp = HAL_I2C_Mem_Write(conn, address, control_byte, 1,
+            const_cast<uint8_t*>(data), size, Transfer_Timeout_Ms(size));
+    if (temp != HAL_OK)
+    {
+        last_error = Error_Of(conn, temp);
+        return false;
+    }
+    return true;
 }
 
-void SSD1306::Write_Data(std::array<uint8_t, SSD1306::buffer_size> &data)
+bool SSD1306::Start_Transfer(uint8_t control_byte, const uint8_t *data,
+        uint16_t size)
 {
-    auto temp = HAL_I2C_Mem_Write(conn, address, control_b_data, 1,
-            data.begin(), height * (width) / 8, 1000);
-    if (temp != 0)
+    // HAL_I2C_Mem_Write_DMA can be used instead if DMA channel is linked to I2C
+    auto temp = HAL_I2C_Mem_Write_IT(conn, address, control_byte, 1,
+            const_cast<uint8_t*>(data), size);
+    if (temp != HAL_OK)
     {
-        last_error = temp;
+        last_error = Error_Of(conn, temp);
+        return false;
     }
+    return true;
 }
@@ -47,12 +47,86 @@
 #ifndef SSD1306_HPP_
 #define SSD1306_HPP_
 
-#include <string>
 #include <array>
 #include <stdint.h>
 #include "fonts.h"
+#include "patterns.h"
 #include "SSD1306_hardware_conf.hpp"
 
+#ifndef SSD1306_VERTICAL_SCRATCH_SIZE
+/// Size of buffer used to send narrow regions in vertical addressing mode in one transfer.
+/// 0 disables vertical addressing.
+#define SSD1306_VERTICAL_SCRATCH_SIZE 64
+#endif
+
+#ifndef SSD1306_STATISTICS
+/// 1 enables collecting of transfer statistics (SSD1306::Get_Statistics). 0 removes them completely.
+#define SSD1306_STATISTICS 0
+#endif
+
+#ifndef SSD1306_STATISTICS_BINS
+/// Number of bins of frame transfer time histogram
+#define SSD1306_STATISTICS_BINS 8
+#endif
+
+#ifndef SSD1306_STATISTICS_BIN_US
+/// Width of one bin of frame transfer time histogram in microseconds
+#define SSD1306_STATISTICS_BIN_US 5000
+#endif
+
+#ifndef SSD1306_STATISTICS_WINDOW
+/// Histogram is halved after this number of frames, so it shows mostly recent ones
+#define SSD1306_STATISTICS_WINDOW 256
+#endif
+
+#ifndef SSD1306_BUS_CLOCK_HZ
+/// Clock of I2C bus, used to compute timeouts of blocking transfers
+#define SSD1306_BUS_CLOCK_HZ 400000
+#endif
+
+#ifndef SSD1306_TIMEOUT_MARGIN
+/// Timeout of transfer is this number of times longer than its expected duration...
+#define SSD1306_TIMEOUT_MARGIN 2
+#endif
+
+#ifndef SSD1306_TIMEOUT_MIN_MS
+/// ...plus this number of milliseconds (covers granularity of system tick)
+#define SSD1306_TIMEOUT_MIN_MS 2
+#endif
+
+#ifndef SSD1306_TRACE
+/// 1 enables trace hook called after every transfer (SSD1306::Set_Trace_Hook, used by SSD1306_Trace).
+/// 0 removes it completely.
+#define SSD1306_TRACE 0
+#endif
+
+#ifndef SSD1306_OSC_BASE_HZ
+/// Oscillator frequency for setting 0 of command 0xD5. Used only to estimate frame period.
+#define SSD1306_OSC_BASE_HZ 175000
+#endif
+
+#ifndef SSD1306_OSC_STEP_HZ
+/// Increase of oscillator frequency per step of setting of command 0xD5 (370kHz for default 0x8).
+#define SSD1306_OSC_STEP_HZ 24400
+#endif
+
+#ifndef SSD1306_POLYGON_MAX_POINTS
+/// Maximal number of vertices of polygon drawn by SSD1306::Fill_Polygon.
+#define SSD1306_POLYGON_MAX_POINTS 16
+#endif
+
+#ifndef SSD1306_BUFFER_ALIGNMENT
+/// Alignment of internal buffer in bytes. At least word size is always used, can be raised to 16 or 32
+/// (e.g. for DMA or cache line). Has to be power of two.
+#define SSD1306_BUFFER_ALIGNMENT 4
+#endif
+
+#ifndef SSD1306_WINDOW_COST
+/// Cost of sending one more window (commands and transfer overhead) in data bytes, used by
+/// SSD1306::Update_Changed. Unchanged parts up to this size are sent instead of splitting window.
+#define SSD1306_WINDOW_COST 10
+#endif
+
 /*! @class SSD1306
  *  @brief This class is controlling display.
  */
@@ -70,23 +144,176 @@ public:
 		ALT_REMAP = 0x32
 	};
 
-	/// Enum for colors. White means pixel is ON.
+	/// Enum for colors. White means pixel is ON. INVERT toggles pixels (XOR), so drawing the same shape
+	/// again restores them (e.g. for cursors and selection highlights).
 	enum Color : uint8_t
 	{
-		BLACK = 0, WHITE = 0xff
+		BLACK = 0, WHITE = 0xff, INVERT = 0x01
+	};
+
+	/// Point of polygon. Can be outside of display.
+	struct Point
+	{
+		int16_t x;
+		int16_t y;
+	};
+
+	/// Controller of display. Many modules sold as SSD1306 are in fact SH1106.
+	enum Controller : uint8_t
+	{
+		CTRL_SSD1306, CTRL_SH1106, CTRL_SSD1309, CTRL_SSD1305
+	};
+
+	/// Differences between supported controllers.
+	struct Controller_Traits
+	{
+		uint8_t column_offset;         ///< RAM column of first visible pixel (SH1106 has 132 columns RAM)
+		bool horizontal_addressing;    ///< false if only page addressing mode (0xB0, 0x00, 0x10) is supported
+		uint8_t dc_dc_command;         ///< command enabling internal DC-DC / charge pump (0xE3 - NOP if not present)
+		uint8_t dc_dc_on;              ///< argument of dc_dc_command when charge pump is used
+		uint8_t dc_dc_off;             ///< argument of dc_dc_command when external VCC is used
+		uint8_t clock;                 ///< recommended display clock divide ratio/oscillator frequency (0xD5)
+		uint8_t contrast;              ///< recommended contrast (0x81)
+		uint8_t precharge;             ///< recommended pre-charge period (0xD9)
+		uint8_t vcomh;                 ///< recommended VCOMH deselect level (0xDB)
+	};
+
+	/**@brief Returns traits of given controller.
+	 */
+	static constexpr Controller_Traits Get_Controller_Traits(Controller controller)
+	{
+		return controller == CTRL_SH1106 ? Controller_Traits { 2, false, 0xAD, 0x8B, 0x8A, 0x80, 150, 0x22, 0x35 } :
+				controller == CTRL_SSD1309 ? Controller_Traits { 0, true, 0xE3, 0xE3, 0xE3, 0x70, 0xDF, 0x82, 0x34 } :
+				controller == CTRL_SSD1305 ? Controller_Traits { 0, true, 0xAD, 0x8F, 0x8E, 0xF0, 0xBF, 0xD2, 0x08 } :
+				Controller_Traits { 0, true, 0x8D, 0x14, 0x10, 0x80, 150, 0x22, 0x40 };
+	}
+
+	/// Parameters of panel used to build initialization sequence by SSD1306::Make_Init_Sequence.
+	/// Default values are suitable for most of SSD1306 modules with internal charge pump,
+	/// for other controllers use SSD1306::Default_Panel_Config.
+	struct Panel_Config
+	{
+		uint8_t height;               ///< height in pixels (16 to 64)
+		HardwareConf com_pins;        ///< COM pins hardware configuration (0xDA)
+		bool charge_pump = true;      ///< internal charge pump enabled (0x8D)
+		uint8_t precharge = 0x22;     ///< pre-charge period (0xD9). Can be 0xf1 if not working.
+		uint8_t vcomh = 0x40;         ///< VCOMH deselect level (0xDB)
+		uint8_t clock = 0x80;         ///< display clock divide ratio/oscillator frequency (0xD5)
+		uint8_t contrast = 150;       ///< initial brightness (0x81)
+		Controller controller = CTRL_SSD1306; ///< controller of display
 	};
 
+	/**@brief Returns panel parameters recommended for given controller.
+	 */
+	static constexpr Panel_Config Default_Panel_Config(uint8_t height,
+			HardwareConf com_pins, Controller controller = CTRL_SSD1306)
+	{
+		return Panel_Config { height, com_pins, controller != CTRL_SSD1309,
+				Get_Controller_Traits(controller).precharge, Get_Controller_Traits(controller).vcomh,
+				Get_Controller_Traits(controller).clock, Get_Controller_Traits(controller).contrast,
+				controller };
+	}
+
+	/// Command stream configuring device, sent by SSD1306::Initialize in one transfer,
+	/// together with controller for which it was built.
+	struct Init_Sequence
+	{
+		typedef std::array<uint8_t, 30> Commands;
+		Commands commands;
+		Controller controller;
+
+		constexpr uint8_t operator[](std::size_t index) const
+		{
+			return commands[index];
+		}
+		const uint8_t* data(void) const
+		{
+			return commands.data();
+		}
+		static constexpr std::size_t size(void)
+		{
+			return std::tuple_size<Commands>::value;
+		}
+	};
+
+	/**@brief Builds initialization sequence. Can be evaluated at compile time, so table is stored in flash:
+	 * @code
+	 * static constexpr SSD1306::Init_Sequence init_128x32 =
+	 *         SSD1306::Make_Init_Sequence({32, SSD1306::SEQ_NOREMAP});
+	 * SSD1306 oled(&hi2c1, init_128x32);
+	 * @endcode
+	 * @param config: parameters of panel.
+	 * @retval Sequence of commands. Commands not supported by controller are replaced with NOP (0xE3).
+	 */
+	static constexpr Init_Sequence Make_Init_Sequence(const Panel_Config &config)
+	{
+		return Init_Sequence { Init_Sequence::Commands { {
+			0xAE, //display off
+			0xD5, //--set display clock divide ratio/oscillator frequency
+			config.clock,
+			0xA8, //--set multiplex ratio(1 to 64) (display height)
+			uint8_t(config.height - 1),
+			0xD3, //-set display offset
+			0x00, //-no offset
+			0x40, //--set start line address
+			Get_Controller_Traits(config.controller).dc_dc_command, //--set DC-DC enable
+			config.charge_pump ? Get_Controller_Traits(config.controller).dc_dc_on :
+					Get_Controller_Traits(config.controller).dc_dc_off,
+			0xA1, //--set segment re-map 0 to 127 (not mirrored)
+			0xC8, //Set COM Output Scan Direction (not flipped)
+			0xDA, //--set com pins hardware configuration
+			config.com_pins,
+			0x81, //--set contrast
+			config.contrast,
+			0xD9, //--set pre-charge period
+			config.precharge,
+			0xDB, //--set vcomh
+			config.vcomh,
+			0xA4, //0xa4,Output follows RAM content;0xa5,Output ignores RAM content
+			0xA6, //normal colours
+			// Horizontal addressing with window covering whole display, or page 0 and first visible column
+			uint8_t(Get_Controller_Traits(config.controller).horizontal_addressing ? 0x20 : 0xB0), //Set Memory Addressing Mode
+			uint8_t(Get_Controller_Traits(config.controller).horizontal_addressing ? 0x00 : //Horizontal Addressing Mode
+					(Get_Controller_Traits(config.controller).column_offset & 0x0F)),
+			uint8_t(Get_Controller_Traits(config.controller).horizontal_addressing ? 0x21 : //Column address
+					(0x10 | (Get_Controller_Traits(config.controller).column_offset >> 4))),
+			uint8_t(Get_Controller_Traits(config.controller).horizontal_addressing ? 0x00 : 0xE3),
+			uint8_t(Get_Controller_Traits(config.controller).horizontal_addressing ? 127 : 0xE3),
+			uint8_t(Get_Controller_Traits(config.controller).horizontal_addressing ? 0x22 : 0xE3), //Page address
+			uint8_t(Get_Controller_Traits(config.controller).horizontal_addressing ? 0x00 : 0xE3),
+			uint8_t(Get_Controller_Traits(config.controller).horizontal_addressing ?
+					(config.height / 8) - 1 : 0xE3)
+		} }, config.controller };
+	}
+
+	/**@brief Computes time of one panel scan: D * K * MUX / Fosc, where K = phase 1 + phase 2 + 50 DCLKs.
+	 * @param clock: argument of 0xD5 command (oscillator setting and divide ratio).
+	 * @param precharge: argument of 0xD9 command (phase 2 and phase 1 period).
+	 * @param multiplex: number of scanned rows (display height).
+	 * @retval Frame period in microseconds.
+	 * @note Oscillator frequency is approximated with SSD1306_OSC_BASE_HZ and SSD1306_OSC_STEP_HZ.
+	 */
+	static constexpr uint32_t Frame_Period_Us(uint8_t clock, uint8_t precharge, uint8_t multiplex)
+	{
+		return uint32_t((clock & 0x0F) + 1) * uint32_t((precharge & 0x0F) + (precharge >> 4) + 50)
+				* multiplex * 1000
+				/ ((SSD1306_OSC_BASE_HZ + uint32_t(clock >> 4) * SSD1306_OSC_STEP_HZ) / 1000);
+	}
+
 	/**@brief Constructor configure class. If height>64 last error=0xff;.
 	 * @param connection_port: I2C class object for HW connection.
 	 * @param screen_height: height in pixels.
 	 * @param hardware_configuration: Can be a value of SSD1306::HardwareConf.
 	 * @param device_address: address of device on I2C line. usually 0x78 is OK.
+	 * @param display_controller: Can be a value of SSD1306::Controller.
 	 */
     SSD1306(SSD1306_I2C_Typedef *connection_port, const uint8_t screen_height,
             HardwareConf hardware_configuration = ALT_NOREMAP,
-            uint8_t device_address = 0x78) :
+            uint8_t device_address = 0x78,
+            Controller display_controller = CTRL_SSD1306) :
             conn(connection_port), height(screen_height),
-                    hard_conf(hardware_configuration), address(device_address)
+                    hard_conf(hardware_configuration), address(device_address),
+                    controller(display_controller)
     {
         if (screen_height > 64)
         {
@@ -94,6 +321,25 @@ public:
         }
     }
 
+	/**@brief Constructor using initialization sequence prepared with SSD1306::Make_Init_Sequence.
+	 * Controller is the one for which \a init_sequence was made.
+	 * @param connection_port: I2C class object for HW connection.
+	 * @param init_sequence: sequence sent by SSD1306::Initialize. Has to outlive this object.
+	 * @param device_address: address of device on I2C line. usually 0x78 is OK.
+	 */
+    SSD1306(SSD1306_I2C_Typedef *connection_port,
+            const Init_Sequence &init_sequence, uint8_t device_address = 0x78) :
+            conn(connection_port), height(init_sequence[init_height_index] + 1),
+                    hard_conf(init_sequence[init_com_pins_index]),
+                    address(device_address), controller(init_sequence.controller),
+                    init_sequence(&init_sequence)
+    {
+        if (height > 64)
+        {
+            last_error = 0xff;
+        }
+    }
+
 	/**@brief Initialize device, cleans display
 	 * @retval True if initialized without errors.
 	 */
@@ -103,15 +349,75 @@ public:
 	 */
 	void Update_Screen(void);
 
+	/**@brief Refresh only part of the screen.
+	 * @param x: X Coordinate
+	 * @param y: Y Coordinate
+	 * @param width: width of region (in pixels)
+	 * @param height: height of region (in pixels)
+	 * @note Vertically region is extended to whole pages (8 pixel rows).
+	 */
+	void Update_Region(uint8_t x, uint8_t y, uint8_t width, uint8_t height);
+
+	/**@brief Enables partial display mode: only rows of given area are scanned, rest of panel is dark.
+	 * Multiplex ratio is lowered, so refresh rate rises and power consumption drops. Updates are limited
+	 * to active pages, updates of other pages are deferred until SSD1306::Exit_Partial_Mode.
+	 * @param y: first active row.
+	 * @param rows: number of active rows.
+	 * @retval False if area is outside of display.
+	 * @note Area is extended to whole pages, and to at least 16 rows (lowest multiplex ratio).
+	 */
+	bool Enter_Partial_Mode(uint8_t y, uint8_t rows);
+
+	/**@brief Restores full display. Inactive pages whose updates were deferred are sent again.
+	 */
+	void Exit_Partial_Mode(void);
+
+	/**@brief Informs if partial display mode is enabled
+	 */
+	bool Is_Partial_Mode(void) const;
+
 	/**@brief Cleans display. Synonymous to calling "Fill(BLACK);"
 	 */
 	void Clean(void);
 
 	/**@brief Fill whole display with one color (turn on or off pixels)
-	 * @param color: Black means display is OFF.
+	 * @param color: Black means display is OFF. INVERT inverts whole buffer.
 	 */
 	void Fill(SSD1306::Color color);
 
+	/**@brief Fill whole display with pattern repeated every 4 columns
+	 * @param pattern: least significant byte is written to columns 0, 4, 8..., next one to columns 1, 5, 9...
+	 * (bit 0 of byte is top row of page). For example 0xAA55AA55 gives checkerboard.
+	 */
+	void Fill_Pattern(uint32_t pattern);
+
+	/**@brief Inverts pixels in rectangle
+	 * @param x: X Coordinate
+	 * @param y: Y Coordinate
+	 * @param width: width of rectangle (in pixels)
+	 * @param height: height of rectangle (in pixels)
+	 * @note Parts outside of display are ignored.
+	 */
+	void Invert_Region(uint8_t x, uint8_t y, uint8_t width, uint8_t height);
+
+	/**@brief Copies rectangle of pixels to other place of buffer, e.g. for software scrolling.
+	 * Source and destination can overlap.
+	 * @param x: X Coordinate of source
+	 * @param y: Y Coordinate of source
+	 * @param width: width of rectangle (in pixels)
+	 * @param height: height of rectangle (in pixels)
+	 * @param to_x: X Coordinate of destination, can be negative
+	 * @param to_y: Y Coordinate of destination, can be negative
+	 * @note Parts moved outside of display are lost. Source is not cleaned.
+	 */
+	void Copy_Region(uint8_t x, uint8_t y, uint8_t width, uint8_t height, int16_t to_x, int16_t to_y);
+
+	/**@brief Compares internal buffer with image
+	 * @param image: array of size 128*64=1024(\a buffer_size), the same layout as in SSD1306::Draw_Image
+	 * @retval True if buffer contains exactly the same data as \a image
+	 */
+	bool Is_Equal(const uint8_t *image) const;
+
 	/**@brief set cursor to given coordinates
 	 * @param x: X Coordinate
 	 * @param y: Y Coordinate
@@ -121,6 +427,7 @@ public:
 
 	/**@brief Writes normal string at coordinates set in SSD1306::Set_Cursor.
 	 * @param str: string to be written
+	 * @note Characters which are not in font (outside of ' '..'~') are drawn as '?'. Text is cut at right edge.
 	 */
 	void Write_String(char const *str);
 
@@ -142,6 +449,15 @@ public:
 	 */
 	void Draw_Image(const uint8_t *image);
 
+	/**@brief Copies rectangle of image to the same place of internal buffer
+	 * @param image: array of size 128*64=1024(\a buffer_size), the same layout as in SSD1306::Draw_Image
+	 * @param x: X Coordinate
+	 * @param y: Y Coordinate
+	 * @param width: width of rectangle (in pixels)
+	 * @param height: height of rectangle (in pixels)
+	 */
+	void Draw_Image_Region(const uint8_t *image, uint8_t x, uint8_t y, uint8_t width, uint8_t height);
+
 	/**@brief Draws Horizontal line
 	 * @param x: X Coordinate
 	 * @param y: Y Coordinate
@@ -163,14 +479,54 @@ public:
 	/**@brief Draws Square
 	 * @param x: X Coordinate
 	 * @param y: Y Coordinate
-	 * @param x2: end of square Y Coordinate
+	 * @param x2: end of square X Coordinate
 	 * @param y2: end of square Y Coordinate
 	 * @param c: Color to draw
-	 * @note Moves from up to bottom and left to right
+	 * @note Corners can be given in any order, parts outside of display are skipped.
 	 */
 	void Draw_Square(uint8_t x, uint8_t y, uint8_t x2, uint8_t y2,
 			SSD1306::Color c);
 
+	/**@brief Draws filled rectangle
+	 * @param x: X Coordinate
+	 * @param y: Y Coordinate
+	 * @param width: width of rectangle (in pixels)
+	 * @param height: height of rectangle (in pixels)
+	 * @param c: Color to draw
+	 * @note Parts outside of display are ignored.
+	 */
+	void Fill_Rectangle(uint8_t x, uint8_t y, uint8_t width, uint8_t height, SSD1306::Color c);
+
+	/**@brief Draws rectangle filled with pattern. It is as fast as solid one.
+	 * @note Unlike SSD1306::Invert_Region, pixels are not toggled - use SSD1306::INVERT color for that.
+	 * @param pattern: e.g. Patterns::checker. Pixels where pattern has 0 are turned off.
+	 */
+	void Fill_Rectangle(uint8_t x, uint8_t y, uint8_t width, uint8_t height,
+			const Patterns::PatternDef &pattern);
+
+	/**@brief Draws filled circle
+	 * @param x: X Coordinate of center
+	 * @param y: Y Coordinate of center
+	 * @param radius: radius (in pixels), 0 draws single pixel
+	 * @param c: Color to draw
+	 */
+	void Fill_Circle(uint8_t x, uint8_t y, uint8_t radius, SSD1306::Color c);
+
+	/**@brief Draws circle filled with pattern
+	 */
+	void Fill_Circle(uint8_t x, uint8_t y, uint8_t radius, const Patterns::PatternDef &pattern);
+
+	/**@brief Draws filled polygon. Pixels whose centers are inside are drawn (even-odd rule).
+	 * @param points: vertices, last one is connected to the first one
+	 * @param count: number of vertices (3 to SSD1306_POLYGON_MAX_POINTS), otherwise nothing is drawn
+	 * @param c: Color to draw
+	 */
+	void Fill_Polygon(const SSD1306::Point *points, uint8_t count, SSD1306::Color c);
+
+	/**@brief Draws polygon filled with pattern
+	 */
+	void Fill_Polygon(const SSD1306::Point *points, uint8_t count, const Patterns::PatternDef &pattern);
+
 	/**@brief Draws Waveform in a plot-like fashion
 	 * @param x: X Start Coordinate
 	 * @param y: Y Start Coordinate
@@ -179,7 +535,7 @@ public:
 	 * @param c: Color to draw
 	 * @note Moves from top to bottom and left to right (value of 0 in buffer data results in
 	 *  drawing pixels in the given \a y coordinates)
-	 * @warning It does not check inputs - User should ensure that buffer<y and size<x!
+	 * @note Points outside of display (value above \a y or beyond right edge) are skipped.
 	 */
 	void Draw_Waveform(uint8_t x, uint8_t y, uint8_t *buffer, uint8_t size,
 			SSD1306::Color c);
@@ -192,6 +548,80 @@ public:
 	 */
 	void Display_On(void);
 
+	/// Errors reported by SSD1306::Get_Last_Error. First values match HAL_StatusTypeDef.
+	enum Error : int
+	{
+		ERROR_NONE = 0,
+		ERROR_BUS = 1,     ///< other bus error (e.g. arbitration lost)
+		ERROR_BUSY = 2,    ///< bus was busy (e.g. SDA held low by other device)
+		ERROR_TIMEOUT = 3, ///< transfer was not finished in time computed by SSD1306::Transfer_Timeout_Ms
+		ERROR_NACK = 4     ///< display did not acknowledge address or byte
+	};
+
+	/**@brief Computes timeout of blocking transfer: expected time of transfer on bus with
+	 * SSD1306_BUS_CLOCK_HZ clock (9 clock cycles per byte, address and control byte included),
+	 * multiplied by SSD1306_TIMEOUT_MARGIN, plus SSD1306_TIMEOUT_MIN_MS.
+	 * @param size: number of bytes after control byte.
+	 * @retval Timeout in milliseconds.
+	 */
+	static constexpr uint32_t Transfer_Timeout_Ms(uint16_t size)
+	{
+		return (uint32_t(size + 2) * 9 * 1000 * SSD1306_TIMEOUT_MARGIN + SSD1306_BUS_CLOCK_HZ - 1)
+				/ SSD1306_BUS_CLOCK_HZ + SSD1306_TIMEOUT_MIN_MS;
+	}
+
+	/// Result of SSD1306::Resume
+	enum Resume_Result : uint8_t
+	{
+		RESUMED,        ///< display was woken up with single command, memory was retained
+		REINITIALIZED,  ///< display had to be initialized again, whole buffer was sent
+		RESUME_FAILED   ///< initialization failed, see SSD1306::Get_Last_Error
+	};
+
+	/**@brief Puts display in sleep mode. Display memory and configuration are retained by controller.
+	 */
+	void Sleep(void);
+
+	/**@brief Wakes display up after SSD1306::Sleep. If display is not initialized, errors occurred
+	 * (see SSD1306::Get_Last_Error) or power probe reports power loss, display is initialized again
+	 * and internal buffer is sent (without cleaning it).
+	 * @retval Can be a value of SSD1306::Resume_Result.
+	 * @note Settings not included in initialization sequence (brightness, inversion, etc.) are lost
+	 * after re-initialization.
+	 */
+	Resume_Result Resume(void);
+
+	/**@brief Sets function used by SSD1306::Resume to check if display was powered all the time.
+	 * @param probe: returns false if display lost power (e.g. from power good pin or flag set on
+	 * power switch), can be nullptr.
+	 * @param context: pointer passed to probe.
+	 */
+	void Set_Power_Probe(bool (*probe)(void *context), void *context);
+
+	/**@brief Sets display clock divide ratio and oscillator frequency. Changes refresh rate of panel.
+	 * @param divide: divide ratio of oscillator, 1-16.
+	 * @param oscillator: oscillator frequency setting, 0-15. Higher value means higher frequency.
+	 */
+	void Set_Clock(uint8_t divide, uint8_t oscillator);
+
+	/**@brief Estimated time of one panel scan for current clock settings and multiplex ratio
+	 * (shorter in partial display mode).
+	 * @retval Frame period in microseconds. See SSD1306::Frame_Period_Us.
+	 */
+	uint32_t Get_Frame_Period_Us(void) const;
+
+	/**@brief Sets start line - row of display memory shown at the top, for vertical scrolling
+	 * without sending buffer. Rows wrap around 64 rows of display memory.
+	 * @param line: 0-63
+	 * @retval False in partial display mode (it uses start line itself), nothing is sent then.
+	 * @note It is set to 0 by SSD1306::Initialize and partial display mode.
+	 */
+	bool Set_Start_Line(uint8_t line);
+
+	/**@brief Number of rows of display
+	 */
+	uint8_t Get_Height(void) const;
+
 	/**@brief Sets brightness of display.
 	 * @param brightness: brightness- 0xff means full lit.
 	 */
@@ -217,13 +647,66 @@ public:
 	 */
 	void Set_Font_size(Fonts::FontDef font);
 
+	/**@brief Returns font set by Set_Font_size().
+	 */
+	Fonts::FontDef Get_Font_size(void) const;
+
+	/// Handling of failed blocking transfers
+	struct Retry_Policy
+	{
+		uint8_t attempts = 1;          ///< number of tries of each transfer, 1 means no retries
+		uint16_t backoff_us = 100;     ///< delay before first retry, doubled before each next one
+		uint16_t max_backoff_us = 5000; ///< upper limit of delay
+		void (*delay_us)(void *context, uint32_t us) = nullptr; ///< delay function, can be nullptr
+		void (*bus_reset)(void *context) = nullptr; ///< called before each retry (e.g. reinitializes I2C peripheral), can be nullptr
+		void *context = nullptr;       ///< passed to \a delay_us and \a bus_reset
+	};
+
+	/**@brief Sets handling of failed blocking transfers.
+	 * @note Part of window which was not sent after all retries is marked for SSD1306::Update_Dirty.
+	 * @note SSD1306_Async retries transfers of display memory with the same policy (\a delay_us is
+	 * called from SSD1306_Async::Executor::Run), commands sent by it are not retried.
+	 */
+	void Set_Retry_Policy(const Retry_Policy &policy);
+
+	/**@brief Sends only parts of buffer changed since they were last sent, or which failed to be sent.
+	 * @note Changes are tracked per page, as span of columns.
+	 */
+	void Update_Dirty(void);
+
+	/**@brief Copies internal buffer
+	 * @param image: array of size 128*64=1024(\a buffer_size), the same layout as in SSD1306::Draw_Image
+	 */
+	void Take_Snapshot(uint8_t *image) const;
+
+	/**@brief Replaces tracked changes with difference between internal buffer and \a shown,
+	 * e.g. after buffer was drawn from scratch or changed without notifying driver.
+	 * @param shown: snapshot of what display shows (taken after last update)
+	 */
+	void Mark_Changes(const uint8_t *shown);
+
+	/**@brief Enables SSD1306::Update_Changed.
+	 * @param shadow: array of size 128*64=1024(\a buffer_size) holding what display shows, e.g. filled by
+	 * SSD1306::Take_Snapshot after SSD1306::Update_Screen. It is updated with every sent part. nullptr disables it.
+	 */
+	void Set_Shadow(uint8_t *shadow);
+
+	/**@brief Sends only columns which differ from shadow set with SSD1306::Set_Shadow, so it is
+	 * efficient also when whole buffer is drawn again every frame (e.g. with SSD1306::Draw_Image).
+	 * Runs of changed columns are merged horizontally and with neighbouring pages if sending
+	 * unchanged bytes costs less than \a SSD1306_WINDOW_COST. Without shadow works as SSD1306::Update_Dirty.
+	 * @note Changes tracked by drawing functions are replaced by result of comparison.
+	 */
+	void Update_Changed(void);
+
 	/**@brief Informs if device is initialized
 	 * @retval True if initialized without errors.
 	 */
 	bool IsInitialized(void) const;
 
 	/**@brief Returns error of underlying I2C interface
-	 * @retval 0 if none error occured since last SSD1306::Clean_Errors call.
+	 * @retval 0 if none error occured since last SSD1306::Clean_Errors call, otherwise usually
+	 * a value of SSD1306::Error.
 	 */
 	int Get_Last_Error(void) const;
 
@@ -231,17 +714,91 @@ public:
 	 */
 	void Clean_Errors(void);
 
+#if SSD1306_STATISTICS
+	/// Counters of transfers, enabled with SSD1306_STATISTICS
+	struct Statistics
+	{
+		uint32_t transfers;        ///< started transfers, including retries
+		uint32_t command_errors;   ///< failed transfers of commands
+		uint32_t data_errors;      ///< failed transfers of display data
+		uint32_t timeouts;         ///< failed transfers which timed out (included in errors above)
+		uint32_t nacks;            ///< failed transfers which were not acknowledged (included in errors above)
+		uint32_t retries;          ///< repeated transfers
+		uint32_t recoveries;       ///< transfers which succeeded after being retried
+		uint32_t worst_latency_us; ///< longest single transfer
+		uint32_t frames;           ///< sent windows of buffer (SSD1306::Update_Screen, SSD1306::Update_Region etc.)
+		/// Histogram of frame transfer times. Bin i counts frames shorter than (i+1)*SSD1306_STATISTICS_BIN_US,
+		/// last one also longer frames. Halved every SSD1306_STATISTICS_WINDOW frames.
+		uint16_t frame_time[SSD1306_STATISTICS_BINS];
+	};
+
+	/**@brief Returns collected statistics.
+	 */
+	const Statistics& Get_Statistics(void) const;
+
+	/**@brief Zeroes all statistics.
+	 */
+	void Clean_Statistics(void);
+
+	/**@brief Sets time source used to measure transfer times.
+	 * @param clock: function returning time in microseconds (it can wrap around), nullptr disables measurements.
+	 */
+	void Set_Statistics_Clock(uint32_t (*clock)(void));
+#endif
+
+	/**@brief Has to be called when non-blocking transfer is finished
+	 * (e.g. from HAL_I2C_MemTxCpltCallback or HAL_I2C_ErrorCallback).
+	 * @param error: error of underlying interface, 0 if transfer succeeded.
+	 */
+	void Transfer_Complete(int error = 0);
+
+	/**@brief Sets function called from SSD1306::Transfer_Complete.
+	 * @param callback: function to be called with \a context and error of transfer, can be nullptr.
+	 * @param context: pointer passed to callback.
+	 * @note Used by SSD1306_Async.
+	 */
+	void Set_Transfer_Callback(void (*callback)(void *context, int error),
+			void *context);
+
+	/**@brief Sets function called after window of buffer was sent to display, e.g. to mirror display remotely.
+	 * @param hook: function called with \a context, internal buffer (the same layout as in SSD1306::Draw_Image)
+	 * and first column, last column, first page and last page of sent window. Can be nullptr.
+	 * @param context: pointer passed to hook.
+	 * @note Used by SSD1306_Mirror.
+	 */
+	void Set_Update_Hook(void (*hook)(void *context, const uint8_t *buffer, uint8_t first_column,
+			uint8_t last_column, uint8_t first_page, uint8_t last_page), void *context);
+
+#if SSD1306_TRACE
+	/**@brief Sets function called after every transfer (blocking or non-blocking), enabled with SSD1306_TRACE.
+	 * @param hook: function called with \a context, control byte (0x00 for commands, 0x40 for display data),
+	 * sent bytes and result of transfer. After whole window of buffer was sent, or its sending failed,
+	 * it is called with \a data equal to nullptr. Can be nullptr.
+	 * @param context: pointer passed to hook.
+	 * @param begin: function called with \a context right before every transfer is started (e.g. to note
+	 * its start time). Can be nullptr.
+	 * @note For non-blocking transfers hook is called from SSD1306::Transfer_Complete. Used by SSD1306_Trace.
+	 */
+	void Set_Trace_Hook(void (*hook)(void *context, uint8_t control_byte, const uint8_t *data, uint16_t size,
+			bool succeeded), void *context, void (*begin)(void *context) = nullptr);
+#endif
+
 private:
 	SSD1306_I2C_Typedef *conn;
 	const uint8_t height;
 	const uint8_t width = 128;
 	const uint8_t hard_conf;
 	const uint8_t address;
+	const Controller controller;
 
 	Fonts::FontDef font = Fonts::font_7x10;  ///<font size
 
 	const static uint32_t buffer_size = 64 / 8 * 128; ///< size of internal buffer. Can be lower if used ONLY with 128x32
-	std::array<uint8_t, buffer_size> buffer; ///<internal buffer used for displaying data
+	alignas(uintptr_t) alignas(SSD1306_BUFFER_ALIGNMENT)
+	std::array<uint8_t, buffer_size> buffer; ///<internal buffer used for displaying data, processed by words
+	static_assert((SSD1306_BUFFER_ALIGNMENT & (SSD1306_BUFFER_ALIGNMENT - 1)) == 0,
+			"SSD1306_BUFFER_ALIGNMENT has to be power of two");
+	static_assert(buffer_size % 32 == 0, "buffer has to consist of whole words");
 	bool isinitialized = false;
 	int last_error = 0;
 
@@ -254,21 +811,311 @@ private:
 		uint8_t Y;
 	} Coordinates;
 
-	/**@brief HW related sends command thru I2C interface.
+	void (*transfer_callback)(void *context, int error) = nullptr;
+	void *transfer_context = nullptr;
+	bool (*power_probe)(void *context) = nullptr;
+	void *power_probe_context = nullptr;
+	void (*update_hook)(void *context, const uint8_t *buffer, uint8_t first_column, uint8_t last_column,
+			uint8_t first_page, uint8_t last_page) = nullptr;
+	void *update_context = nullptr;
+	Retry_Policy retry;
+
+#if SSD1306_STATISTICS
+	Statistics statistics = { };
+	uint32_t (*statistics_clock)(void) = nullptr;
+	uint16_t window_frames = 0; ///<frames since histogram was halved
+	uint32_t transfer_start = 0; ///<start of non-blocking transfer
+	uint8_t transfer_control = 0; ///<control byte of non-blocking transfer
+
+	uint32_t Statistics_Time(void) const
+	{
+		return statistics_clock != nullptr ? statistics_clock() : 0;
+	}
+	void Record_Transfer(uint8_t control_byte, bool succeeded, uint32_t start);
+	void Record_Frame(uint32_t start);
+#endif
+
+#if SSD1306_TRACE
+	void (*trace_hook)(void *context, uint8_t control_byte, const uint8_t *data, uint16_t size,
+			bool succeeded) = nullptr;
+	void (*trace_begin)(void *context) = nullptr;
+	void *trace_context = nullptr;
+	const uint8_t *trace_data = nullptr; ///<bytes of non-blocking transfer
+	uint16_t trace_size = 0; ///<size of non-blocking transfer
+	uint8_t trace_control = 0; ///<control byte of non-blocking transfer
+
+	void Trace(uint8_t control_byte, const uint8_t *data, uint16_t size, bool succeeded) const
+	{
+		if (trace_hook != nullptr)
+		{
+			trace_hook(trace_context, control_byte, data, size, succeeded);
+		}
+	}
+	void Trace_Begin(void) const
+	{
+		if (trace_begin != nullptr)
+		{
+			trace_begin(trace_context);
+		}
+	}
+#endif
+
+	/// Part of display memory in units used by SSD1306 addressing commands
+	struct Window
+	{
+		uint8_t first_column;
+		uint8_t last_column;
+		uint8_t first_page;
+		uint8_t last_page;
+	};
+
+	/// Memory addressing modes (argument of 0x20 command)
+	enum Addressing : uint8_t
+	{
+		HORIZONTAL = 0, VERTICAL = 1, PAGE = 2, UNKNOWN = 0xff
+	};
+	uint8_t addressing = HORIZONTAL; ///<addressing mode currently set in device
+
+	/*! @class Window_Writer
+	 *  @brief Splits sending of window into transfers. The same sequence is used by blocking
+	 *  and awaitable functions.
+	 *
+	 *  Narrow regions spanning more than one page are gathered column by column and sent in one
+	 *  transfer in vertical addressing mode, other regions are sent in horizontal mode page by page
+	 *  (or at once if they are as wide as display). Controllers without these modes get page addressing.
+	 */
+	class Window_Writer
+	{
+	public:
+		Window_Writer(SSD1306 &display, const Window &window);
+
+		/**@brief Prepares next transfer.
+		 * @param control_byte: SSD1306::control_b_command or SSD1306::control_b_data.
+		 * @param data: bytes to send, valid until next call.
+		 * @param size: number of bytes to send.
+		 * @retval False if whole window was already sent.
+		 */
+		bool Next(uint8_t &control_byte, const uint8_t *&data, uint16_t &size);
+
+		/**@brief Informs that last transfer failed and will be retried. Next transfers start with
+		 * commands setting display pointer to beginning of failed one.
+		 */
+		void Rewind(uint8_t control_byte);
+
+		/**@brief Informs that last transfer failed. Window from last transfer to the end is marked
+		 * for SSD1306::Update_Dirty.
+		 */
+		void Failed(uint8_t control_byte);
+
+	private:
+		SSD1306 &display;
+		Window window;
+		uint8_t mode;
+		uint8_t page;
+		uint8_t transfer_page = 0; ///<first page of last transfer
+		bool commands_sent = false;
+		uint8_t commands[8];
+#if SSD1306_VERTICAL_SCRATCH_SIZE > 0
+		uint8_t scratch[SSD1306_VERTICAL_SCRATCH_SIZE];
+#endif
+	};
+
+	/**@brief Sends window of internal buffer to display memory, using addressing supported by controller.
+	 */
+	void Write_Window(const Window &window);
+
+	/**@brief Informs update hook that whole \a window was sent.
+	 */
+	void Window_Sent(const Window &window) const
+	{
+		if (update_hook != nullptr)
+		{
+			update_hook(update_context, buffer.data(), window.first_column, window.last_column,
+					window.first_page, window.last_page);
+		}
+	}
+
+	/**@brief Converts region in pixels to window clipped to display size.
+	 * @retval False if region is empty or outside of display.
+	 */
+	bool Clip_Region(uint8_t x, uint8_t y, uint8_t width, uint8_t height,
+			Window &window) const;
+
+	const static uint8_t init_height_index = 4; ///< position of multiplex ratio in SSD1306::Init_Sequence
+	const static uint8_t init_com_pins_index = 13; ///< position of COM pins configuration in SSD1306::Init_Sequence
+	const static uint8_t init_clock_index = 2; ///< position of clock settings in SSD1306::Init_Sequence
+	const static uint8_t init_precharge_index = 17; ///< position of pre-charge period in SSD1306::Init_Sequence
+	const Init_Sequence *init_sequence = nullptr; ///<sequence given in constructor
+	uint8_t clock = 0x80; ///<current argument of 0xD5 command
+	uint8_t precharge = 0x22; ///<current argument of 0xD9 command
+	bool flipped = false; ///<COM scan direction is not remapped (0xC0)
+
+	const static uint8_t max_pages = buffer_size / 128;
+	bool partial = false; ///<partial display mode enabled
+	uint8_t partial_first_page = 0;
+	uint8_t partial_last_page = 0;
+	uint8_t deferred_pages = 0; ///<bit mask of inactive pages whose update was skipped in partial mode
+
+	uint8_t dirty_begin[max_pages] = { }; ///<first changed column of page
+	uint8_t dirty_end[max_pages] = { }; ///<column after last changed one, page is clean if it is not above \a dirty_begin
+	uint8_t *shadow = nullptr; ///<copy of what display shows, used by SSD1306::Update_Changed
+	const static uint8_t max_changed_windows = 16; ///<windows of one page kept by SSD1306::Update_Changed
+
+	/**@brief Adds columns of \a page to changed ones.
+	 */
+	void Mark_Dirty(uint8_t page, uint8_t first_column, uint8_t last_column)
+	{
+		if (dirty_begin[page] >= dirty_end[page])
+		{
+			dirty_begin[page] = first_column;
+			dirty_end[page] = uint8_t(last_column + 1);
+			return;
+		}
+		if (first_column < dirty_begin[page])
+		{
+			dirty_begin[page] = first_column;
+		}
+		if (last_column >= dirty_end[page])
+		{
+			dirty_end[page] = uint8_t(last_column + 1);
+		}
+	}
+
+	/**@brief Marks all pages of \a window as changed.
+	 */
+	void Mark_Dirty(const Window &window);
+
+	/**@brief Marks pages covered by \a window as not changed.
+	 */
+	void Clear_Dirty(const Window &window);
+
+	/**@brief Finds next run of changed pages, starting from \a page.
+	 * @retval False if there are no more changed pages.
+	 */
+	bool Next_Dirty_Window(uint8_t page, Window &window) const;
+
+	/**@brief Copies active part of \a window to shadow and sends it.
+	 */
+	void Write_Changed(Window window);
+
+	/**@brief Number of rows scanned by display (multiplex ratio).
+	 */
+	uint8_t Scanned_Rows(void) const
+	{
+		return partial ? uint8_t((partial_last_page - partial_first_page + 1) * 8) : height;
+	}
+
+	/**@brief Enables partial mode for pages of \a window without sending anything.
+	 */
+	void Set_Partial_State(Window window);
+
+	/// Pattern with drawing operation, used by filled shapes
+	struct Brush
+	{
+		const Patterns::PatternDef &pattern;
+		bool invert; ///<pixels set in pattern are toggled and others are kept, instead of writing pattern
+	};
+
+	/**@brief Brush drawing with solid \a color
+	 */
+	static Brush Brush_Of(SSD1306::Color color);
+
+	void Fill_Rectangle(uint8_t x, uint8_t y, uint8_t width, uint8_t height, const Brush &brush);
+	void Fill_Circle(uint8_t x, uint8_t y, uint8_t radius, const Brush &brush);
+	void Fill_Polygon(const SSD1306::Point *points, uint8_t count, const Brush &brush);
+
+	/**@brief Draws \a brush on rows from \a first_row to \a last_row of column \a x, clipped to display.
+	 * Whole page bytes are written at once.
+	 */
+	void Fill_Column(int16_t x, int16_t first_row, int16_t last_row, const Brush &brush);
+
+	/**@brief Fills \a commands with multiplex ratio, display offset and start line for current mode.
+	 * Active rows are kept in the same place of panel for both COM scan directions.
+	 * @retval Number of bytes (always 5).
+	 */
+	uint8_t Partial_Mode_Commands(uint8_t *commands) const;
+
+	/**@brief Limits \a window to active pages in partial mode, and marks rest of it as deferred.
+	 * @retval False if nothing is left to send.
+	 */
+	bool Limit_To_Active_Pages(Window &window);
+
+	/**@brief Takes next run of pages whose update was deferred in partial mode.
+	 * @retval False if there is nothing more to send.
+	 */
+	bool Next_Stale_Window(Window &window);
+
+	/**@brief Builds argument of 0xD5 command, parameters are limited to allowed range.
+	 */
+	static uint8_t Make_Clock(uint8_t divide, uint8_t oscillator);
+
+	/**@brief Returns sequence given in constructor, or builds one in \a storage with default panel parameters.
+	 */
+	const Init_Sequence& Get_Init_Sequence(Init_Sequence &storage) const;
+
+	/**@brief Sets state of class to match controller after \a sequence was sent.
+	 */
+	void Reset_State(const Init_Sequence &sequence);
+
+	/**@brief Sends initialization sequence.
+	 */
+	void Configure(void);
+
+	/**@brief Checks if display has to be initialized again on resume.
+	 */
+	bool Needs_Reinitialization(void) const;
+
+	/**@brief Sends command, retrying according to SSD1306::Retry_Policy.
 	 * @param command: byte to send.
+	 * @retval True if command was sent.
+	 */
+	bool Write_Command(uint8_t command);
+
+	/**@brief Sends stream of commands in one transfer, retrying according to SSD1306::Retry_Policy.
+	 * @param commands: pointer to bytes to send.
+	 * @param size: number of bytes to send.
+	 * @retval True if commands were sent.
+	 */
+	bool Write_Commands(const uint8_t *commands, uint16_t size);
+
+	/**@brief Transmits bytes with retries and bus resets between them.
 	 */
-	void Write_Command(uint8_t command);
+	bool Send(uint8_t control_byte, const uint8_t *data, uint16_t size);
 
-	/**@brief HW related sends command thru I2C interface.
-	 * @param data: byte array size of SSD1306::buffer_size to send.
+	/**@brief Single attempt of blocking transfer, counted in statistics.
 	 */
-	void Write_Data(std::array<uint8_t, buffer_size> &data);
+	bool Transfer(uint8_t control_byte, const uint8_t *data, uint16_t size);
+
+	/**@brief Calls bus reset and waits before next attempt.
+	 * @retval False if all attempts were used.
+	 */
+	bool Prepare_Retry(uint8_t &attempt, uint32_t &backoff);
+
+	/**@brief HW related sends bytes thru I2C interface in one blocking transfer, with timeout
+	 * from SSD1306::Transfer_Timeout_Ms. Sets SSD1306::last_error to value of SSD1306::Error on failure.
+	 * @param control_byte: SSD1306::control_b_command or SSD1306::control_b_data.
+	 * @param data: pointer to bytes to send.
+	 * @param size: number of bytes to send.
+	 * @retval True if all bytes were acknowledged.
+	 */
+	bool Transmit(uint8_t control_byte, const uint8_t *data, uint16_t size);
+
+	/**@brief HW related starts non-blocking transfer thru I2C interface.
+	 * End of transfer has to be reported with SSD1306::Transfer_Complete.
+	 * @param control_byte: SSD1306::control_b_command or SSD1306::control_b_data.
+	 * @param data: pointer to bytes to send. Must be valid until transfer ends.
+	 * @param size: number of bytes to send.
+	 * @retval True if transfer was started.
+	 */
+	bool Start_Transfer(uint8_t control_byte, const uint8_t *data, uint16_t size);
 
     /**@brief Used internaly by \ref Write_String to draw one character at the time
      * @param chr: character
      * @param color: Color of character
      */
 	void Write_Char(char chr, SSD1306::Color color);
+
+	friend class SSD1306_Async;
 };
 
 #endif /* SSD1306_HPP_ */
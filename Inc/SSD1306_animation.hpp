@@ -0,0 +1,168 @@
+/**
+ ******************************************************************************
+ * @file    SSD1306_animation.hpp
+ * @author  agent
+ * @date    17.10.2026
+ * @brief   Keyframe animation scheduler for OLED display
+ ******************************************************************************
+ * <h2><center>&copy; COPYRIGHT(c) 2026 agent
+ * </center></h2>
+ *
+ *Permission is hereby granted, free of charge,
+ *to any person obtaining a copy of this software and associated documentation files
+ *(the "Software"), to deal in the Software without restriction,
+ *including without limitation the rights to use, copy, modify,
+ *merge, publish, distribute, sublicense, and/or sell copies of
+ *the Software, and to permit persons to whom the Software is furnished to do so,
+ *subject to the following conditions:
+ *
+ *The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ *THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ *INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ *PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ *FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************************************
+ */
+
+#ifndef SSD1306_ANIMATION_HPP_
+#define SSD1306_ANIMATION_HPP_
+
+#include <stdint.h>
+#include "SSD1306.hpp"
+
+#ifndef SSD1306_ANIMATION_SLOTS
+#define SSD1306_ANIMATION_SLOTS 8 ///< number of animations which can run at once
+#endif
+
+/*! @class SSD1306_Animator
+ *  @brief Moves and changes frames of animated objects (icons, spinners, blinking values) along keyframes.
+ *
+ *  On each SSD1306_Animator::Tick only objects whose position or frame changed are cleared and drawn
+ *  again (with objects overlapping them), and one rectangle containing all changes is sent to display.
+ *  Time is taken only from given time source, so animations can be tested with fake clock.
+ *  Usage:
+ *  @code
+ *  void Draw_Spinner(void *context, SSD1306 &display, int16_t x, int16_t y, uint8_t frame);
+ *  const SSD1306_Animator::Keyframe spin[] = { { 0, 100, 0, 0 }, { 100000, 100, 0, 1 },
+ *          { 200000, 100, 0, 2 }, { 300000, 100, 0, 0 } };
+ *  SSD1306_Animator animator(oled, Micros);
+ *  animator.Start(SSD1306_Animator::Animation { Draw_Spinner, nullptr, 16, 16, spin, 4, true });
+ *  while (1)
+ *  {
+ *      animator.Tick();
+ *  }
+ *  @endcode
+ *  @note Objects are drawn on black background - area left by object is cleared.
+ */
+class SSD1306_Animator
+{
+public:
+	/// Draws object with top left corner at \a x, \a y (can be partially outside of display)
+	typedef void (*Draw_Function)(void *context, SSD1306 &display, int16_t x, int16_t y, uint8_t frame);
+
+	/// State of object at given time. Position is interpolated linearly to next keyframe, frame is not.
+	struct Keyframe
+	{
+		uint32_t time_us; ///< time from start of animation, has to grow in next keyframes
+		int16_t x;
+		int16_t y;
+		uint8_t frame; ///< passed to SSD1306_Animator::Draw_Function
+	};
+
+	struct Animation
+	{
+		Draw_Function draw;
+		void *context;        ///< passed to \a draw
+		uint8_t width;        ///< size of object, area cleared when it moves
+		uint8_t height;
+		const Keyframe *keyframes; ///< has to exist as long as animation runs
+		uint8_t count;        ///< number of keyframes
+		bool loop;            ///< start again after last keyframe, otherwise object stays at last one until it is stopped
+	};
+
+	/// Rectangle of display
+	struct Region
+	{
+		uint8_t x;
+		uint8_t y;
+		uint8_t width;
+		uint8_t height;
+	};
+
+	/**@brief Constructor.
+	 * @param display: display to draw on.
+	 * @param time_source: function returning time in microseconds. It can wrap around.
+	 */
+	SSD1306_Animator(SSD1306 &display, uint32_t (*time_source)(void));
+
+	/**@brief Starts animation at current time. It is drawn on next SSD1306_Animator::Tick.
+	 * @retval Slot of animation, -1 if all SSD1306_ANIMATION_SLOTS are used or \a animation has no keyframes.
+	 */
+	int8_t Start(const Animation &animation);
+
+	/**@brief Stops animation, its object is cleared and slot is freed on next SSD1306_Animator::Tick.
+	 * @note Ended animations which do not loop keep their slot (and object on display) until they are stopped.
+	 */
+	void Stop(int8_t slot);
+
+	/**@brief Informs if animation in \a slot runs (false for ended animations which do not loop)
+	 */
+	bool Is_Running(int8_t slot) const;
+
+	/**@brief Draws changed objects and sends region containing them with SSD1306::Update_Region.
+	 * @retval True if anything was sent.
+	 */
+	bool Tick(void);
+
+	/**@brief Region sent by last SSD1306_Animator::Tick which sent anything
+	 */
+	const Region& Get_Last_Region(void) const;
+
+private:
+	/// Animation in progress
+	struct Slot
+	{
+		Animation animation;
+		uint32_t start;
+		int16_t x;      ///<position and frame drawn last time
+		int16_t y;
+		uint8_t frame;
+		bool used = false;
+		bool drawn = false;
+		bool ended = false;    ///<last keyframe of animation which does not loop was reached
+		bool stopping = false;
+	};
+
+	/// Rectangle with coordinates outside of display, before clipping
+	struct Bounds
+	{
+		int16_t left;
+		int16_t top;
+		int16_t right; ///<exclusive
+		int16_t bottom; ///<exclusive
+	};
+
+	SSD1306 &oled;
+	uint32_t (*now)(void);
+	Slot slots[SSD1306_ANIMATION_SLOTS];
+	Region last_region = { 0, 0, 0, 0 };
+
+	/// Position and frame of animation after \a elapsed microseconds. Returns false if animation ended.
+	static bool State_At(const Animation &animation, uint32_t elapsed, Keyframe &state);
+
+	static Bounds Bounds_Of(const Slot &slot);
+	static bool Overlap(const Bounds &a, const Bounds &b);
+	static void Join(Bounds &total, const Bounds &bounds);
+
+	/// Part of \a bounds inside of display, false if there is none
+	bool Clip(const Bounds &bounds, Region &region) const;
+
+	/// Clears part of display covered by \a bounds
+	void Clear(const Bounds &bounds);
+};
+
+#endif /* SSD1306_ANIMATION_HPP_ */
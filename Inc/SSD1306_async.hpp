@@ -0,0 +1,387 @@
+/**
+ ******************************************************************************
+ * @file    SSD1306_async.hpp
+ * @author  agent
+ * @date    17.10.2026
+ * @brief   Awaitable (C++20 coroutines) interface for OLED display
+ ******************************************************************************
+ * <h2><center>&copy; COPYRIGHT(c) 2026 agent
+ * </center></h2>
+ *
+ *Permission is hereby granted, free of charge,
+ *to any person obtaining a copy of this software and associated documentation files
+ *(the "Software"), to deal in the Software without restriction,
+ *including without limitation the rights to use, copy, modify,
+ *merge, publish, distribute, sublicense, and/or sell copies of
+ *the Software, and to permit persons to whom the Software is furnished to do so,
+ *subject to the following conditions:
+ *
+ *The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ *THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ *INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ *PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ *FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************************************
+ */
+
+#ifndef SSD1306_ASYNC_HPP_
+#define SSD1306_ASYNC_HPP_
+
+#if !defined(__cpp_impl_coroutine)
+#error "SSD1306_async.hpp requires C++20 compiler with coroutines enabled"
+#endif
+
+#include <coroutine>
+#include <stddef.h>
+#include <stdint.h>
+#include "SSD1306.hpp"
+
+#ifndef SSD1306_ASYNC_FRAME_SIZE
+#define SSD1306_ASYNC_FRAME_SIZE 384 ///< size of one coroutine frame slot in bytes
+#endif
+
+#ifndef SSD1306_ASYNC_FRAMES
+#define SSD1306_ASYNC_FRAMES 8 ///< number of coroutine frames which can exist at once (max 32)
+#endif
+
+#ifndef SSD1306_ASYNC_QUEUE_SIZE
+#define SSD1306_ASYNC_QUEUE_SIZE 8 ///< number of coroutines which can wait for SSD1306_Async::Executor::Run
+#endif
+
+/*! @class SSD1306_Async
+ *  @brief Awaitable versions of SSD1306 functions.
+ *
+ *  Each function returns SSD1306_Async::Task which is suspended while underlying interface is busy
+ *  and resumed (from SSD1306_Async::Executor::Run) after SSD1306::Transfer_Complete is called.
+ *  Coroutine frames are taken from static arena, heap is never used.
+ *  Usage:
+ *  @code
+ *  SSD1306_Async::Executor executor;
+ *  SSD1306_Async async_oled(oled, executor);
+ *
+ *  SSD1306_Async::Task Show(void)
+ *  {
+ *      co_await async_oled.Initialize();
+ *      oled.Write_String("Hello!");
+ *      co_await async_oled.Update_Screen();
+ *  }
+ *
+ *  auto task = Show();
+ *  executor.Start(task);
+ *  while (1)
+ *  {
+ *      executor.Run();
+ *  }
+ *  // and in HAL_I2C_MemTxCpltCallback: oled.Transfer_Complete();
+ *  @endcode
+ *  @note Only one transfer for given display can be in progress - do not run two tasks
+ *  using the same display concurrently.
+ */
+class SSD1306_Async
+{
+public:
+	class Task;
+
+	/*! @class Frame_Arena
+	 *  @brief Static storage for coroutine frames.
+	 */
+	class Frame_Arena
+	{
+	public:
+		/**@brief Returns free slot or nullptr if there is none or \a size is too big
+		 */
+		static void *Allocate(size_t size) noexcept;
+
+		/**@brief Returns slot to arena
+		 */
+		static void Free(void *frame) noexcept;
+
+		/**@brief Number of slots currently used
+		 */
+		static uint8_t Frames_In_Use(void) noexcept;
+
+	private:
+		alignas(max_align_t) static uint8_t memory[SSD1306_ASYNC_FRAMES][SSD1306_ASYNC_FRAME_SIZE];
+		static uint32_t used; ///<bit mask of used slots
+	};
+
+	/*! @class Executor
+	 *  @brief Minimal single threaded executor. Coroutines are resumed only from SSD1306_Async::Executor::Run.
+	 *
+	 *  Started tasks and posted coroutines are kept in separate queues, so each queue has only one writer:
+	 *  Start and Run are called from main loop, Post from transfer complete interrupt.
+	 */
+	class Executor
+	{
+	public:
+		/**@brief Schedules task to be started on next SSD1306_Async::Executor::Run call
+		 * @param task: task to start. It has to outlive its execution.
+		 * @note Call only from the same context as SSD1306_Async::Executor::Run (not from interrupt).
+		 * @retval False if queue is full.
+		 */
+		bool Start(Task &task);
+
+		/**@brief Schedules coroutine to be resumed.
+		 * @note Can be called from interrupt or from main loop, but only from one of them for given executor
+		 * (e.g. all displays using it complete transfers in interrupts of the same priority).
+		 * @retval False if queue is full.
+		 */
+		bool Post(std::coroutine_handle<> handle);
+
+		/**@brief Starts scheduled tasks and resumes all posted coroutines. Call from main loop.
+		 * @retval Number of resumed coroutines.
+		 */
+		uint32_t Run(void);
+
+		/**@brief Informs if no coroutine is waiting for SSD1306_Async::Executor::Run
+		 */
+		bool Is_Idle(void) const;
+
+	private:
+		std::coroutine_handle<> queue[SSD1306_ASYNC_QUEUE_SIZE + 1]; ///<written only by Post
+		volatile uint8_t head = 0;
+		volatile uint8_t tail = 0;
+		std::coroutine_handle<> started[SSD1306_ASYNC_QUEUE_SIZE + 1]; ///<written only by Start
+		uint8_t started_head = 0;
+		uint8_t started_tail = 0;
+	};
+
+	/*! @class Task
+	 *  @brief Lazily started coroutine returning true if all transfers succeeded.
+	 */
+	class Task
+	{
+	public:
+		struct promise_type
+		{
+			std::coroutine_handle<> continuation;
+			bool result = false;
+
+			static void *operator new(size_t size) noexcept
+			{
+				return Frame_Arena::Allocate(size);
+			}
+			static void operator delete(void *frame) noexcept
+			{
+				Frame_Arena::Free(frame);
+			}
+			static Task get_return_object_on_allocation_failure(void) noexcept
+			{
+				return Task();
+			}
+			Task get_return_object(void) noexcept
+			{
+				return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+			}
+			std::suspend_always initial_suspend(void) noexcept
+			{
+				return {};
+			}
+			auto final_suspend(void) noexcept
+			{
+				struct Final_Awaiter
+				{
+					bool await_ready(void) noexcept
+					{
+						return false;
+					}
+					std::coroutine_handle<> await_suspend(
+							std::coroutine_handle<promise_type> handle) noexcept
+					{
+						if (handle.promise().continuation)
+						{
+							return handle.promise().continuation;
+						}
+						return std::noop_coroutine();
+					}
+					void await_resume(void) noexcept
+					{
+					}
+				};
+				return Final_Awaiter { };
+			}
+			void return_value(bool ok) noexcept
+			{
+				result = ok;
+			}
+			void unhandled_exception(void) noexcept;
+		};
+
+		Task() = default;
+		Task(Task &&other) noexcept :
+				handle(other.handle)
+		{
+			other.handle = nullptr;
+		}
+		Task& operator=(Task &&other) noexcept;
+		Task(const Task&) = delete;
+		Task& operator=(const Task&) = delete;
+		~Task();
+
+		/**@brief False if frame could not be allocated
+		 */
+		bool Is_Valid(void) const
+		{
+			return bool(handle);
+		}
+
+		/**@brief True if task finished (or was never created)
+		 */
+		bool Is_Done(void) const
+		{
+			return !handle || handle.done();
+		}
+
+		/**@brief Value returned by finished task. False if task is not valid.
+		 */
+		bool Result(void) const
+		{
+			return handle && handle.done() && handle.promise().result;
+		}
+
+		bool await_ready(void) const noexcept
+		{
+			return !handle;
+		}
+		std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+		{
+			handle.promise().continuation = awaiting;
+			return handle;
+		}
+		bool await_resume(void) const noexcept
+		{
+			return Result();
+		}
+
+	private:
+		explicit Task(std::coroutine_handle<promise_type> h) :
+				handle(h)
+		{
+		}
+		std::coroutine_handle<promise_type> handle = nullptr;
+
+		friend class Executor;
+	};
+
+	/**@brief Constructor. Registers itself as transfer callback of \a display.
+	 * @param display: display to control.
+	 * @param executor: executor resuming coroutines after transfer is completed.
+	 */
+	SSD1306_Async(SSD1306 &display, Executor &executor);
+	~SSD1306_Async();
+	SSD1306_Async(const SSD1306_Async&) = delete;
+	SSD1306_Async& operator=(const SSD1306_Async&) = delete;
+
+	/**@brief Awaitable version of SSD1306::Initialize
+	 */
+	Task Initialize(void);
+
+	/**@brief Awaitable version of SSD1306::Update_Screen
+	 */
+	Task Update_Screen(void);
+
+	/**@brief Awaitable version of SSD1306::Update_Region
+	 */
+	Task Update_Region(uint8_t x, uint8_t y, uint8_t width, uint8_t height);
+
+	/**@brief Awaitable version of SSD1306::Enter_Partial_Mode
+	 */
+	Task Enter_Partial_Mode(uint8_t y, uint8_t rows);
+
+	/**@brief Awaitable version of SSD1306::Exit_Partial_Mode
+	 */
+	Task Exit_Partial_Mode(void);
+
+	/**@brief Awaitable version of SSD1306::Display_Off
+	 */
+	Task Display_Off(void);
+
+	/**@brief Awaitable version of SSD1306::Display_On
+	 */
+	Task Display_On(void);
+
+	/**@brief Awaitable version of SSD1306::Set_Clock
+	 */
+	Task Set_Clock(uint8_t divide, uint8_t oscillator);
+
+	/**@brief Awaitable version of SSD1306::Sleep
+	 */
+	Task Sleep(void);
+
+	/**@brief Awaitable version of SSD1306::Resume
+	 * @note Task result is true if display was resumed or initialized again without errors.
+	 */
+	Task Resume(void);
+
+	/**@brief Awaitable version of SSD1306::Set_Brightness
+	 */
+	Task Set_Brightness(uint8_t brightness);
+
+	/**@brief Awaitable version of SSD1306::Invert_Colors
+	 */
+	Task Invert_Colors(bool inverted);
+
+	/**@brief Awaitable version of SSD1306::Flip_Screen
+	 */
+	Task Flip_Screen(bool flipped);
+
+	/**@brief Awaitable version of SSD1306::Mirror_Screen
+	 */
+	Task Mirror_Screen(bool mirrored);
+
+	/**@brief Informs if transfer is in progress
+	 */
+	bool Is_Busy(void) const
+	{
+		return bool(waiting);
+	}
+
+private:
+	SSD1306 &oled;
+	Executor &executor;
+	std::coroutine_handle<> waiting; ///<coroutine suspended until end of transfer
+	int transfer_error = 0;
+
+	/// Suspends coroutine until transfer started by SSD1306::Start_Transfer is finished
+	struct Transfer_Awaiter
+	{
+		SSD1306_Async &self;
+		uint8_t control_byte;
+		const uint8_t *data;
+		uint16_t size;
+
+		bool await_ready(void) noexcept
+		{
+			return false;
+		}
+		bool await_suspend(std::coroutine_handle<> handle) noexcept;
+		bool await_resume(void) noexcept
+		{
+			return self.transfer_error == 0;
+		}
+	};
+
+	Transfer_Awaiter Write_Commands(const uint8_t *commands, uint16_t size)
+	{
+		return Transfer_Awaiter { *this, oled.control_b_command, commands, size };
+	}
+
+	Transfer_Awaiter Write_Data(const uint8_t *data, uint16_t size)
+	{
+		return Transfer_Awaiter { *this, oled.control_b_data, data, size };
+	}
+
+	/// Sends initialization sequence
+	Task Configure(void);
+
+	/// Sends window of display buffer, used by all update functions
+	Task Write_Window(SSD1306::Window window);
+
+	static void On_Transfer_Complete(void *context, int error);
+};
+
+#endif /* SSD1306_ASYNC_HPP_ */
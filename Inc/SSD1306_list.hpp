@@ -0,0 +1,136 @@
+/**
+ ******************************************************************************
+ * @file    SSD1306_list.hpp
+ * @author  agent
+ * @date    17.10.2026
+ * @brief   Scrolling list widget for OLED display
+ ******************************************************************************
+ * <h2><center>&copy; COPYRIGHT(c) 2026 agent
+ * </center></h2>
+ *
+ *Permission is hereby granted, free of charge,
+ *to any person obtaining a copy of this software and associated documentation files
+ *(the "Software"), to deal in the Software without restriction,
+ *including without limitation the rights to use, copy, modify,
+ *merge, publish, distribute, sublicense, and/or sell copies of
+ *the Software, and to permit persons to whom the Software is furnished to do so,
+ *subject to the following conditions:
+ *
+ *The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ *THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ *INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ *PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ *FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************************************
+ */
+
+#ifndef SSD1306_LIST_HPP_
+#define SSD1306_LIST_HPP_
+
+#include <stdint.h>
+#include "SSD1306.hpp"
+
+/*! @class SSD1306_List
+ *  @brief List (menu) of any number of text items, only visible rows are drawn.
+ *
+ *  Scrolling moves already drawn rows with SSD1306::Copy_Region and draws only rows which appeared,
+ *  selection is shown with SSD1306::Invert_Region. Changed parts of buffer are tracked by display,
+ *  so SSD1306::Update_Dirty sends only them.
+ *  Usage:
+ *  @code
+ *  const char *Setting_Name(void *context, uint16_t index); // returns text of item
+ *  SSD1306_List menu(oled, Setting_Name, nullptr, 300);
+ *
+ *  menu.Draw();
+ *  oled.Update_Dirty();
+ *  while (1)
+ *  {
+ *      if (Key_Down())
+ *      {
+ *          menu.Next();
+ *          oled.Update_Dirty();
+ *      }
+ *  }
+ *  @endcode
+ *  @note Font of display is restored after drawing. Characters outside of ' '..'~' are drawn as '?'.
+ */
+class SSD1306_List
+{
+public:
+	/// Returns text of item \a index (can be temporary, it is not stored)
+	typedef const char *(*Item_Text)(void *context, uint16_t index);
+
+	/**@brief Constructor. Nothing is drawn until SSD1306_List::Draw is called.
+	 * @param display: display to draw on.
+	 * @param text: function returning text of items.
+	 * @param context: passed to \a text.
+	 * @param count: number of items.
+	 * @param x: X Coordinate of list
+	 * @param y: Y Coordinate of list
+	 * @param width: width of list (in pixels)
+	 * @param height: height of list (in pixels), rows which do not fit entirely are not used
+	 * @param font: font of items. Row is 2 pixels higher than font.
+	 */
+	SSD1306_List(SSD1306 &display, Item_Text text, void *context, uint16_t count, uint8_t x = 0,
+			uint8_t y = 0, uint8_t width = 128, uint8_t height = 64, Fonts::FontDef font = Fonts::font_7x10);
+
+	/**@brief Draws all visible rows and selection
+	 */
+	void Draw(void);
+
+	/**@brief Moves selection to item \a index, scrolling list so that it is visible.
+	 * @param index: item to select, limited to number of items.
+	 */
+	void Select(uint16_t index);
+
+	/**@brief Selects next item, if there is one
+	 */
+	void Next(void);
+
+	/**@brief Selects previous item, if there is one
+	 */
+	void Previous(void);
+
+	/**@brief Changes number of items and draws list again
+	 */
+	void Set_Count(uint16_t count);
+
+	uint16_t Get_Selected(void) const;
+
+	/**@brief Index of item in first row
+	 */
+	uint16_t Get_First_Visible(void) const;
+
+	/**@brief Number of rows which fit into list
+	 */
+	uint8_t Get_Visible_Rows(void) const;
+
+private:
+	SSD1306 &oled;
+	Item_Text text;
+	void *context;
+	uint16_t count;
+	const uint8_t x;
+	const uint8_t y;
+	const uint8_t width;
+	const Fonts::FontDef font;
+	const uint8_t row_height;
+	const uint8_t rows;
+	uint16_t first = 0; ///<item in first row
+	uint16_t selected = 0;
+
+	/// Clears row and draws item \a index in it (if it exists), without selection
+	void Draw_Row(uint8_t row, uint16_t index);
+
+	/// Toggles selection bar of selected item
+	void Invert_Selection(void);
+
+	/// Scrolls to \a new_first, reusing rows which stay visible
+	void Scroll(uint16_t new_first);
+};
+
+#endif /* SSD1306_LIST_HPP_ */
@@ -0,0 +1,167 @@
+/**
+ ******************************************************************************
+ * @file    SSD1306_mirror.hpp
+ * @author  agent
+ * @date    17.10.2026
+ * @brief   Streaming of display content for remote view
+ ******************************************************************************
+ * <h2><center>&copy; COPYRIGHT(c) 2026 agent
+ * </center></h2>
+ *
+ *Permission is hereby granted, free of charge,
+ *to any person obtaining a copy of this software and associated documentation files
+ *(the "Software"), to deal in the Software without restriction,
+ *including without limitation the rights to use, copy, modify,
+ *merge, publish, distribute, sublicense, and/or sell copies of
+ *the Software, and to permit persons to whom the Software is furnished to do so,
+ *subject to the following conditions:
+ *
+ *The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ *THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ *INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ *PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ *FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************************************
+ */
+
+#ifndef SSD1306_MIRROR_HPP_
+#define SSD1306_MIRROR_HPP_
+
+#include <stdint.h>
+#include "SSD1306.hpp"
+#include "SSD1306_snapshot.hpp"
+
+#ifndef SSD1306_MIRROR_KEYFRAME_INTERVAL
+#define SSD1306_MIRROR_KEYFRAME_INTERVAL 32 ///< every n-th packet sent by SSD1306_Mirror contains whole screen
+#endif
+
+/*! @class SSD1306_Mirror
+ *  @brief Streams what is sent to display over any byte stream (UART, TCP, pipe), so it can be watched remotely.
+ *
+ *  Each window sent by update functions becomes one packet: SSD1306_Mirror::sync, type
+ *  (SSD1306_Mirror::keyframe or SSD1306_Mirror::delta), sequence number, length of payload (2 bytes,
+ *  little endian), payload and 8-bit sum of payload. Payload consists of records of SSD1306_Snapshot delta
+ *  format (page, column, length, bytes), one for each page of window. Keyframe contains all pages. It is sent
+ *  first, every \a keyframe_interval packets and after failed write; receiver which lost or rejected
+ *  a packet ignores deltas until next keyframe. SSD1306_Mirror::Decoder rebuilds image on receiving side,
+ *  *Tests/mirror_view* is host program converting stream to PBM images.
+ *  Usage:
+ *  @code
+ *  bool Uart_Write(void *context, const uint8_t *data, uint16_t size)
+ *  {
+ *      return HAL_UART_Transmit(&huart2, const_cast<uint8_t*>(data), size, 10) == HAL_OK;
+ *  }
+ *  SSD1306_Mirror mirror(oled, Uart_Write, nullptr);
+ *  @endcode
+ *  @note Writer is called from update functions, so slow stream slows down updates of display.
+ */
+class SSD1306_Mirror
+{
+public:
+	/// Writes bytes to stream, returns false if they were not written
+	typedef bool (*Writer)(void *context, const uint8_t *data, uint16_t size);
+
+	static const uint8_t sync = 0xA5; ///< first byte of packet
+	static const uint8_t keyframe = 'K'; ///< type of packet containing whole screen
+	static const uint8_t delta = 'D'; ///< type of packet containing sent window
+	static const uint16_t max_payload = 8 * (3 + 128); ///< all pages with record headers
+
+	/*! @class Decoder
+	 *  @brief Rebuilds image from stream made by SSD1306_Mirror. Does not use heap, can run on host or other MCU.
+	 */
+	class Decoder
+	{
+	public:
+		/**@brief Processes next byte of stream
+		 * @retval True if it completed packet which was applied to image.
+		 */
+		bool Feed(uint8_t byte);
+
+		/**@brief Processes bytes of stream
+		 * @retval Number of packets applied to image.
+		 */
+		uint16_t Feed(const uint8_t *data, uint32_t size);
+
+		/**@brief Reconstructed image, the same layout as in SSD1306::Draw_Image
+		 */
+		const uint8_t* Image(void) const
+		{
+			return image;
+		}
+
+		/**@brief Informs if image shows what display shows (keyframe was received and no packet was lost since)
+		 */
+		bool Is_Synchronized(void) const
+		{
+			return synchronized;
+		}
+
+		/**@brief Number of corrupted, malformed and lost packets
+		 */
+		uint32_t Get_Errors(void) const
+		{
+			return errors;
+		}
+
+	private:
+		enum State : uint8_t
+		{
+			SYNC, TYPE, SEQUENCE, LENGTH_LOW, LENGTH_HIGH, PAYLOAD, CHECKSUM
+		};
+		State state = SYNC;
+		uint8_t type = 0;
+		uint8_t sequence = 0;
+		uint8_t expected_sequence = 0;
+		uint16_t length = 0;
+		uint16_t received = 0;
+		uint8_t sum = 0;
+		bool synchronized = false;
+		uint32_t errors = 0;
+		uint8_t payload[max_payload];
+		uint8_t image[SSD1306_Snapshot::size] = { };
+
+		/**@brief Checks and applies completed packet
+		 */
+		bool Complete(uint8_t checksum);
+	};
+
+	/**@brief Constructor. Registers itself as update hook of \a display.
+	 * @param display: display to mirror.
+	 * @param write: function writing to stream.
+	 * @param context: pointer passed to \a write.
+	 * @param keyframe_interval: number of packets after which keyframe is sent, 0 sends keyframes only when needed.
+	 */
+	SSD1306_Mirror(SSD1306 &display, Writer write, void *context,
+			uint16_t keyframe_interval = SSD1306_MIRROR_KEYFRAME_INTERVAL);
+	~SSD1306_Mirror();
+	SSD1306_Mirror(const SSD1306_Mirror&) = delete;
+	SSD1306_Mirror& operator=(const SSD1306_Mirror&) = delete;
+
+	/**@brief Makes next packet a keyframe, e.g. when viewer was connected.
+	 */
+	void Request_Keyframe(void);
+
+private:
+	SSD1306 &oled;
+	Writer write;
+	void *context;
+	uint16_t keyframe_interval;
+	uint16_t packets_since_keyframe = 0;
+	bool keyframe_needed = true;
+	uint8_t sequence = 0;
+
+	/**@brief Writes packet with window of \a buffer
+	 * @retval False if some part of packet was not written.
+	 */
+	bool Send(const uint8_t *buffer, uint8_t type, uint8_t first_column, uint8_t last_column,
+			uint8_t first_page, uint8_t last_page);
+
+	static void On_Update(void *context, const uint8_t *buffer, uint8_t first_column, uint8_t last_column,
+			uint8_t first_page, uint8_t last_page);
+};
+
+#endif /* SSD1306_MIRROR_HPP_ */
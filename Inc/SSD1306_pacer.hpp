@@ -0,0 +1,133 @@
+/**
+ ******************************************************************************
+ * @file    SSD1306_pacer.hpp
+ * @author  agent
+ * @date    17.10.2026
+ * @brief   Frame pacing for OLED display
+ ******************************************************************************
+ * <h2><center>&copy; COPYRIGHT(c) 2026 agent
+ * </center></h2>
+ *
+ *Permission is hereby granted, free of charge,
+ *to any person obtaining a copy of this software and associated documentation files
+ *(the "Software"), to deal in the Software without restriction,
+ *including without limitation the rights to use, copy, modify,
+ *merge, publish, distribute, sublicense, and/or sell copies of
+ *the Software, and to permit persons to whom the Software is furnished to do so,
+ *subject to the following conditions:
+ *
+ *The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ *THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ *INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ *PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ *FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************************************
+ */
+
+#ifndef SSD1306_PACER_HPP_
+#define SSD1306_PACER_HPP_
+
+#include <stdint.h>
+#include "SSD1306.hpp"
+
+#ifndef SSD1306_PACER_WINDOW_DIV
+/// Transfer may start only in first 1/SSD1306_PACER_WINDOW_DIV part of frame period after scan boundary
+#define SSD1306_PACER_WINDOW_DIV 4
+#endif
+
+/*! @class SSD1306_Frame_Pacer
+ *  @brief Schedules sending of frames to display.
+ *
+ *  Frames are sent right after estimated start of panel scan (estimated from SSD1306::Get_Frame_Period_Us
+ *  and moment of SSD1306_Frame_Pacer::Synchronize), not more often than allowed maximal frame rate.
+ *  Frame submitted before previous one was sent replaces it - previous one is dropped.
+ *  Usage:
+ *  @code
+ *  uint32_t Micros(void); // e.g. DWT->CYCCNT / (SystemCoreClock / 1000000)
+ *  SSD1306_Frame_Pacer pacer(oled, Micros, 30);
+ *
+ *  oled.Initialize();
+ *  pacer.Synchronize();
+ *  while (1)
+ *  {
+ *      if (new_data)
+ *      {
+ *          Draw(oled);
+ *          pacer.Submit();
+ *      }
+ *      pacer.Poll(); // calls oled.Update_Screen() when it is time
+ *  }
+ *  @endcode
+ *  @note Poll has to be called at least once per SSD1306::Get_Frame_Period_Us / SSD1306_PACER_WINDOW_DIV,
+ *  otherwise start window can be missed.
+ *  @note Estimated scan start is moved to latest scan boundary on each SSD1306_Frame_Pacer::Submit and
+ *  SSD1306_Frame_Pacer::Mark_Sent. If none of them is called for longer than time source wraps around
+ *  (71 minutes for microseconds), call SSD1306_Frame_Pacer::Synchronize again.
+ */
+class SSD1306_Frame_Pacer
+{
+public:
+	/**@brief Constructor.
+	 * @param display: display to refresh.
+	 * @param time_source: function returning time in microseconds. It can wrap around.
+	 * @param max_fps: maximal number of frames sent per second, 0 means no limit except panel refresh rate.
+	 */
+	SSD1306_Frame_Pacer(SSD1306 &display, uint32_t (*time_source)(void), uint16_t max_fps = 0);
+
+	/**@brief Sets maximal number of frames sent per second.
+	 * @param max_fps: 0 means no limit except panel refresh rate.
+	 */
+	void Set_Max_Fps(uint16_t max_fps);
+
+	/**@brief Sets current moment as start of panel scan.
+	 * Should be called after SSD1306::Initialize, SSD1306::Display_On or SSD1306::Set_Clock.
+	 */
+	void Synchronize(void);
+
+	/**@brief Informs that buffer of display contains new frame.
+	 */
+	void Submit(void);
+
+	/**@brief Checks if submitted frame should be sent now.
+	 * @retval True if frame is waiting, frame rate limit allows it and scan boundary has just passed.
+	 */
+	bool Is_Frame_Due(void) const;
+
+	/**@brief Informs that frame is being sent. Used if frame is sent by other means than
+	 * SSD1306_Frame_Pacer::Poll (e.g. with SSD1306_Async::Update_Screen).
+	 */
+	void Mark_Sent(void);
+
+	/**@brief Sends frame with SSD1306::Update_Screen if it is due.
+	 * @retval True if frame was sent.
+	 */
+	bool Poll(void);
+
+	/**@brief Number of submitted frames which were replaced before sending
+	 */
+	uint32_t Get_Dropped_Frames(void) const;
+
+	/**@brief Number of sent frames
+	 */
+	uint32_t Get_Sent_Frames(void) const;
+
+private:
+	SSD1306 &oled;
+	uint32_t (*now)(void);
+	uint32_t min_interval = 0; ///<minimal time between frames in microseconds
+	uint32_t scan_start = 0; ///<moment of any panel scan start
+	uint32_t last_sent = 0;
+	bool pending = false; ///<frame submitted but not sent
+	bool sent_any = false;
+	uint32_t dropped = 0;
+	uint32_t sent = 0;
+
+	/// Moves scan_start to last scan boundary before \a time
+	void Anchor(uint32_t time);
+};
+
+#endif /* SSD1306_PACER_HPP_ */
@@ -0,0 +1,102 @@
+/**
+ ******************************************************************************
+ * @file    SSD1306_snapshot.hpp
+ * @author  agent
+ * @date    17.10.2026
+ * @brief   Delta and run-length encoding of display snapshots
+ ******************************************************************************
+ * <h2><center>&copy; COPYRIGHT(c) 2026 agent
+ * </center></h2>
+ *
+ *Permission is hereby granted, free of charge,
+ *to any person obtaining a copy of this software and associated documentation files
+ *(the "Software"), to deal in the Software without restriction,
+ *including without limitation the rights to use, copy, modify,
+ *merge, publish, distribute, sublicense, and/or sell copies of
+ *the Software, and to permit persons to whom the Software is furnished to do so,
+ *subject to the following conditions:
+ *
+ *The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ *THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ *INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ *PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ *FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************************************
+ */
+
+#ifndef SSD1306_SNAPSHOT_HPP_
+#define SSD1306_SNAPSHOT_HPP_
+
+#include <stdint.h>
+
+/*! @class SSD1306_Snapshot
+ *  @brief Compact encodings of snapshots taken with SSD1306::Take_Snapshot (e.g. for remote view of display).
+ *
+ *  Delta consists of records: page (0-7), first column (0-127), number of bytes n (1-128)
+ *  and n new bytes of page. Changes separated by less than 3 unchanged bytes share one record.
+ *  Run-length encoding of whole frame consists of packets: control byte c with c < 128 is followed by
+ *  c+1 literal bytes, control byte c >= 128 is followed by one byte repeated c-126 times.
+ *  Usage:
+ *  @code
+ *  static uint8_t sent[SSD1306_Snapshot::size], now[SSD1306_Snapshot::size], delta[512];
+ *  uint16_t size;
+ *  oled.Take_Snapshot(now);
+ *  if (SSD1306_Snapshot::Encode_Delta(sent, now, delta, sizeof(delta), size))
+ *  {
+ *      Send(delta, size); // receiver calls SSD1306_Snapshot::Apply_Delta on its copy
+ *      memcpy(sent, now, sizeof(now));
+ *  }
+ *  @endcode
+ */
+class SSD1306_Snapshot
+{
+public:
+	static const uint16_t size = 1024; ///< size of snapshot (128x64 display)
+
+	/**@brief Encodes changes from snapshot \a from to snapshot \a to
+	 * @param delta: output
+	 * @param capacity: size of \a delta
+	 * @param delta_size: number of bytes written to \a delta, 0 if snapshots are equal
+	 * @retval False if delta does not fit in \a capacity bytes.
+	 */
+	static bool Encode_Delta(const uint8_t *from, const uint8_t *to, uint8_t *delta, uint16_t capacity,
+			uint16_t &delta_size);
+
+	/**@brief Applies delta made by SSD1306_Snapshot::Encode_Delta to \a image
+	 * @retval False if delta is malformed, \a image can be partially changed then.
+	 */
+	static bool Apply_Delta(uint8_t *image, const uint8_t *delta, uint16_t delta_size);
+
+	/**@brief Run-length encodes whole snapshot
+	 * @param output: output
+	 * @param capacity: size of \a output
+	 * @param output_size: number of bytes written to \a output
+	 * @retval False if encoded snapshot does not fit in \a capacity bytes.
+	 */
+	static bool Encode_Rle(const uint8_t *image, uint8_t *output, uint16_t capacity, uint16_t &output_size);
+
+	/**@brief Decodes snapshot encoded by SSD1306_Snapshot::Encode_Rle
+	 * @retval False if input is malformed or does not contain exactly SSD1306_Snapshot::size bytes.
+	 */
+	static bool Decode_Rle(const uint8_t *input, uint16_t input_size, uint8_t *image);
+
+	static const uint16_t pbm_size = 10 + size; ///< size of snapshot converted by SSD1306_Snapshot::Encode_Pbm
+
+	/**@brief Converts snapshot to binary PBM image (P4, 128x64), lit pixels are black
+	 * @param output: array of size SSD1306_Snapshot::pbm_size
+	 * @retval Number of bytes written to \a output.
+	 */
+	static uint16_t Encode_Pbm(const uint8_t *image, uint8_t *output);
+
+private:
+	static const uint8_t width = 128;
+	static const uint8_t record_header = 3; ///<page, column and length of delta record
+	static const uint8_t max_literal = 128;
+	static const uint8_t max_run = 129;
+};
+
+#endif /* SSD1306_SNAPSHOT_HPP_ */
@@ -0,0 +1,200 @@
+/**
+ ******************************************************************************
+ * @file    SSD1306_trace.hpp
+ * @author  agent
+ * @date    18.10.2026
+ * @brief   Recording and decoding of command stream sent to display
+ ******************************************************************************
+ * <h2><center>&copy; COPYRIGHT(c) 2026 agent
+ * </center></h2>
+ *
+ *Permission is hereby granted, free of charge,
+ *to any person obtaining a copy of this software and associated documentation files
+ *(the "Software"), to deal in the Software without restriction,
+ *including without limitation the rights to use, copy, modify,
+ *merge, publish, distribute, sublicense, and/or sell copies of
+ *the Software, and to permit persons to whom the Software is furnished to do so,
+ *subject to the following conditions:
+ *
+ *The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ *THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ *INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ *PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ *FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************************************
+ */
+
+#ifndef SSD1306_TRACE_HPP_
+#define SSD1306_TRACE_HPP_
+
+#include <stdint.h>
+#include "SSD1306.hpp"
+
+#if !SSD1306_TRACE
+#error "SSD1306_trace.hpp requires SSD1306_TRACE defined as 1 (e.g. in SSD1306_hardware_conf.hpp)"
+#endif
+
+#ifndef SSD1306_TRACE_ENTRIES
+#define SSD1306_TRACE_ENTRIES 64 ///< size of ring buffer of SSD1306_Trace, oldest entries are overwritten
+#endif
+
+#ifndef SSD1306_TRACE_BYTES
+#define SSD1306_TRACE_BYTES 8 ///< command bytes kept in one entry, longer transfers take more entries
+#endif
+
+/*! @class SSD1306_Trace
+ *  @brief Records transfers sent to display in ring buffer and prints them as readable commands.
+ *
+ *  Each transfer is stored with time of its start and end of window with time of its end, so frame time
+ *  covers all its transfers. Commands are kept byte by byte, for display data only size is kept. SSD1306_Trace::Print decodes commands (SET_COLUMN 0..127, SET_PAGE 0..7, scroll setup...)
+ *  and after every window of buffer prints totals of this frame. Recording does not use heap nor printf,
+ *  so it can be left running on target and printed when display misbehaves.
+ *  Usage:
+ *  @code
+ *  // SSD1306_hardware_conf.hpp: #define SSD1306_TRACE 1
+ *  void Uart_Print(void *context, const char *line)
+ *  {
+ *      HAL_UART_Transmit(&huart2, (uint8_t*) line, strlen(line), 100);
+ *  }
+ *  SSD1306_Trace trace(oled, Micros);
+ *  ...
+ *  trace.Print(Uart_Print, nullptr);
+ *  @endcode
+ *  Output:
+ *  @code
+ *      1200 us  SET_COLUMN 0..127
+ *      1200 us  SET_PAGE 0..7
+ *      1890 us  DATA 1024 bytes
+ *               FRAME 1: 2 transfers, 6 command bytes, 1024 data bytes, 0 errors, 24510 us
+ *  @endcode
+ */
+class SSD1306_Trace
+{
+public:
+	/// Called with each line of output, \a line is terminated by '\n'
+	typedef void (*Printer)(void *context, const char *line);
+
+	/// Kind of entry, flags SSD1306_Trace::continued and SSD1306_Trace::failed can be added
+	enum Type : uint8_t
+	{
+		COMMANDS = 0, ///< command bytes
+		DATA = 1,     ///< display data
+		WINDOW = 2    ///< end of window of buffer, ends frame
+	};
+	static const uint8_t type_mask = 0x03;
+	static const uint8_t continued = 0x40; ///< next part of transfer which did not fit in previous entry
+	static const uint8_t failed = 0x80;    ///< transfer (or window) was not acknowledged
+
+	/// One recorded transfer or its part
+	struct Entry
+	{
+		uint32_t time;  ///< start of transfer (end of window) from clock given in constructor, 0 if there is none
+		uint16_t size;  ///< number of bytes of whole transfer
+		uint8_t type;   ///< SSD1306_Trace::Type with flags
+		uint8_t count;  ///< number of valid bytes in \a bytes
+		uint8_t bytes[SSD1306_TRACE_BYTES]; ///< command bytes
+	};
+
+	/*! @class Command_Decoder
+	 *  @brief Converts command bytes to text. Commands can be split between transfers, as display
+	 *  also accepts them this way. Can be used alone, e.g. for bytes captured by logic analyzer.
+	 */
+	class Command_Decoder
+	{
+	public:
+		/**@brief Takes next command byte.
+		 * @retval True if command is complete, its text is returned by SSD1306_Trace::Command_Decoder::Text.
+		 */
+		bool Feed(uint8_t byte);
+
+		/**@brief Text of last complete command, e.g. "SET_PAGE 0..7"
+		 */
+		const char* Text(void) const
+		{
+			return text;
+		}
+
+		/**@brief Informs if command was started and waits for arguments
+		 */
+		bool Is_Pending(void) const
+		{
+			return received != 0;
+		}
+
+		/**@brief Forgets started command
+		 */
+		void Reset(void)
+		{
+			received = 0;
+		}
+
+	private:
+		uint8_t command[7];
+		uint8_t received = 0;
+		char text[48];
+
+		/// Number of argument bytes following \a opcode
+		static uint8_t Arguments(uint8_t opcode);
+		void Format(void);
+	};
+
+	/**@brief Constructor. Registers itself as trace hook of \a display.
+	 * @param display: display whose transfers are recorded.
+	 * @param clock: function returning time in microseconds (it can wrap around), can be nullptr.
+	 */
+	SSD1306_Trace(SSD1306 &display, uint32_t (*clock)(void) = nullptr);
+	~SSD1306_Trace();
+	SSD1306_Trace(const SSD1306_Trace&) = delete;
+	SSD1306_Trace& operator=(const SSD1306_Trace&) = delete;
+
+	/**@brief Removes all entries
+	 */
+	void Clear(void);
+
+	/**@brief Stops or resumes recording, e.g. to keep transfers before error until they are printed
+	 */
+	void Pause(bool paused);
+
+	/**@brief Number of stored entries
+	 */
+	uint16_t Size(void) const;
+
+	/**@brief Entry number \a index, 0 is the oldest one
+	 */
+	const Entry& Get(uint16_t index) const;
+
+	/**@brief Number of entries overwritten since last SSD1306_Trace::Clear
+	 */
+	uint32_t Get_Dropped(void) const
+	{
+		return dropped;
+	}
+
+	/**@brief Decodes stored entries, oldest first, and prints them line by line.
+	 * Frame totals are printed after each window of buffer, totals of all entries at the end.
+	 */
+	void Print(Printer print, void *context) const;
+
+private:
+	SSD1306 &oled;
+	uint32_t (*clock)(void);
+	Entry entries[SSD1306_TRACE_ENTRIES];
+	uint16_t first = 0; ///<index of oldest entry
+	uint16_t count = 0;
+	uint32_t dropped = 0;
+	uint32_t begin_time = 0; ///<start of transfer in progress
+	bool paused = false;
+
+	/// Adds entry, overwrites the oldest one if buffer is full
+	Entry& Add(void);
+
+	static void On_Begin(void *context);
+	static void On_Transfer(void *context, uint8_t control_byte, const uint8_t *data, uint16_t size,
+			bool succeeded);
+};
+
+#endif /* SSD1306_TRACE_HPP_ */
@@ -0,0 +1,108 @@
+/**
+ ******************************************************************************
+ * @file    SSD1306_transition.hpp
+ * @author  agent
+ * @date    17.10.2026
+ * @brief   Screen transition effects for OLED display
+ ******************************************************************************
+ * <h2><center>&copy; COPYRIGHT(c) 2026 agent
+ * </center></h2>
+ *
+ *Permission is hereby granted, free of charge,
+ *to any person obtaining a copy of this software and associated documentation files
+ *(the "Software"), to deal in the Software without restriction,
+ *including without limitation the rights to use, copy, modify,
+ *merge, publish, distribute, sublicense, and/or sell copies of
+ *the Software, and to permit persons to whom the Software is furnished to do so,
+ *subject to the following conditions:
+ *
+ *The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ *THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ *INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ *PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ *FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************************************
+ */
+
+#ifndef SSD1306_TRANSITION_HPP_
+#define SSD1306_TRANSITION_HPP_
+
+#include <stdint.h>
+#include "SSD1306.hpp"
+
+/*! @class SSD1306_Transition
+ *  @brief Replaces content of display with next screen step by step, sending only revealed parts.
+ *
+ *  Next screen is drawn off-screen into image of the same layout as for SSD1306::Draw_Image.
+ *  Each step copies revealed part of it to buffer of display and sends only that part, so whole
+ *  transition costs about one full frame of transfers. Slides move current screen with start line
+ *  (SSD1306::Set_Start_Line), so one page is sent per step.
+ *  Usage:
+ *  @code
+ *  static uint8_t next_screen[1024];
+ *  Draw_Settings(next_screen);
+ *  SSD1306_Transition transition(oled);
+ *  transition.Start(next_screen, SSD1306_Transition::SLIDE_UP);
+ *  while (transition.Step())
+ *  {
+ *      HAL_Delay(20); // or step on frame pacer
+ *  }
+ *  @endcode
+ *  @note Image has to be kept unchanged until transition is finished. Nothing should be drawn on
+ *  display during transition. At the end buffer of display contains image.
+ */
+class SSD1306_Transition
+{
+public:
+	enum Effect : uint8_t
+	{
+		SLIDE_UP,   ///< next screen pushes current one up (one page per step, only 64 row displays)
+		SLIDE_DOWN, ///< next screen pushes current one down (one page per step, only 64 row displays)
+		WIPE_LEFT,  ///< next screen is revealed from right edge
+		WIPE_RIGHT, ///< next screen is revealed from left edge
+		WIPE_UP,    ///< next screen is revealed from bottom edge
+		WIPE_DOWN,  ///< next screen is revealed from top edge
+		DISSOLVE    ///< next screen is revealed in 8x8 blocks in scattered order
+	};
+
+	explicit SSD1306_Transition(SSD1306 &display);
+
+	/**@brief Starts transition, nothing is drawn until SSD1306_Transition::Step.
+	 * @param image: next screen, array of size 128*64=1024(\a buffer_size)
+	 * @param effect: effect of transition. Slides on displays with less than 64 rows become wipes
+	 * in the same direction. With flipped screen slides go in opposite direction.
+	 * @param steps: number of steps (slides always have one step per page)
+	 * @retval False if display is in partial mode or \a image is null.
+	 */
+	bool Start(const uint8_t *image, Effect effect, uint8_t steps = 8);
+
+	/**@brief Reveals and sends next part of image
+	 * @retval True if transition is not finished yet.
+	 */
+	bool Step(void);
+
+	/**@brief Makes all remaining steps at once
+	 */
+	void Finish(void);
+
+	bool Is_Running(void) const;
+
+private:
+	SSD1306 &oled;
+	const uint8_t *next = nullptr; ///<image revealed by transition, null if none is running
+	Effect effect = WIPE_LEFT;
+	uint8_t steps = 0;
+	uint8_t step = 0;
+
+	/// Copies part of image to display buffer and sends it
+	void Reveal(uint8_t x, uint8_t y, uint8_t width, uint8_t height);
+
+	/// Position in \a extent (width, height or number of blocks) where part revealed in step \a index begins
+	uint8_t Band_Begin(uint8_t extent, uint8_t index) const;
+};
+
+#endif /* SSD1306_TRANSITION_HPP_ */
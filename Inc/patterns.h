@@ -0,0 +1,55 @@
+/**
+ ******************************************************************************
+ * @file    patterns.h
+ * @author  agent
+ * @date    17.10.2026
+ * @brief   8x8 patterns for filling shapes
+ ******************************************************************************
+ * <h2><center>&copy; COPYRIGHT(c) 2026 agent
+ * </center></h2>
+ *
+ *Permission is hereby granted, free of charge,
+ *to any person obtaining a copy of this software and associated documentation files
+ *(the "Software"), to deal in the Software without restriction,
+ *including without limitation the rights to use, copy, modify,
+ *merge, publish, distribute, sublicense, and/or sell copies of
+ *the Software, and to permit persons to whom the Software is furnished to do so,
+ *subject to the following conditions:
+ *
+ *The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ *THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ *INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ *PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ *FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************************************
+ */
+
+#include <stdint.h>
+
+#ifndef _Patterns_HPP
+#define _Patterns_HPP
+
+namespace Patterns {
+/// Pattern is repeated every 8 pixels in both directions, anchored at top left corner of display.
+/// Each byte is one column, in the same layout as display memory: bit 0 is the top row.
+typedef struct {
+	uint8_t Columns[8]; /*!< Column bytes, for pixel x,y bit y%8 of Columns[x%8] is used */
+} PatternDef;
+
+const PatternDef solid = {{0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF}};
+const PatternDef checker = {{0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA}};
+const PatternDef diagonal = {{0x11, 0x22, 0x44, 0x88, 0x11, 0x22, 0x44, 0x88}};      ///< "\" lines
+const PatternDef back_diagonal = {{0x11, 0x88, 0x44, 0x22, 0x11, 0x88, 0x44, 0x22}}; ///< "/" lines
+const PatternDef cross_hatch = {{0x11, 0xAA, 0x44, 0xAA, 0x11, 0xAA, 0x44, 0xAA}};
+const PatternDef dots = {{0x01, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00}};
+const PatternDef gray_12 = {{0x11, 0x00, 0x44, 0x00, 0x11, 0x00, 0x44, 0x00}};
+const PatternDef gray_25 = {{0x11, 0x44, 0x11, 0x44, 0x11, 0x44, 0x11, 0x44}};
+const PatternDef gray_50 = checker;
+const PatternDef gray_75 = {{0xEE, 0xBB, 0xEE, 0xBB, 0xEE, 0xBB, 0xEE, 0xBB}};
+
+}
+#endif
@@ -32,93 +32,1010 @@
  */
 
 #include <stdint.h>
+#include <string.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 #include "SSD1306.hpp"
 
 bool SSD1306::Initialize(void)
 {
-    Display_Off();
-    Write_Command(0xD5); //--set display clock divide ratio/oscillator frequency
-    Write_Command(0x80); //--set divide ratio  <default value> //*
-    Write_Command(0xA8); //--set multiplex ratio(1 to 64) (display height)
-    Write_Command(height - 1);
-    Write_Command(0xD3); //-set display offset
-    Write_Command(0x00); //-no offset
-    Write_Command(0x40); //--set start line address
-    Write_Command(0x8D); //--set DC-DC enable
-    Write_Command(0x14); //	enable charge pump
-    Mirror_Screen(false);
-    Flip_Screen(false);
-    Write_Command(0xDA); //--set com pins hardware configuration
-    Write_Command(hard_conf);
-    Set_Brightness(150);
-    Write_Command(0xD9); //--set pre-charge period
-    Write_Command(0x22); //can be 0xf1 if not working.
-    Write_Command(0xDB); //--set vcomh
-    Write_Command(0x40); //0x20,0.77xVcc
-    Write_Command(0xA4); //0xa4,Output follows RAM content;0xa5,Output ignores RAM content
-    Invert_Colors(false);
-    Write_Command(0x20); //Set Memory Addressing Mode
-    Write_Command(0x00); //00,Horizontal Addressing Mode;01,Vertical Addressing Mode;10,Page Addressing Mode (RESET);11,Invalid
-
-    Write_Command(0x21); //Column address
-    Write_Command(0x00);
-    Write_Command(width - 1);
-    Write_Command(0x22); //Page address
-    Write_Command(0x00);
-    Write_Command((height / 8) - 1);
+    Configure();
+    Display_On();
+    Clean();
+    Update_Screen();
+
+    if (last_error == 0)
+    {
+        isinitialized = true;
+    }
+    else
+    {
+        isinitialized = false;
+    }
+
+    return isinitialized;
+}
+
+const SSD1306::Init_Sequence& SSD1306::Get_Init_Sequence(Init_Sequence &storage) const
+{
+    if (init_sequence != nullptr)
+    {
+        return *init_sequence;
+    }
+    storage = Make_Init_Sequence(
+            Default_Panel_Config(height, HardwareConf(hard_conf), controller));
+    return storage;
+}
+
+void SSD1306::Reset_State(const Init_Sequence &sequence)
+{
+    clock = sequence[init_clock_index];
+    precharge = sequence[init_precharge_index];
+    flipped = false;
+    partial = false;
+    deferred_pages = 0;
+    addressing = Get_Controller_Traits(controller).horizontal_addressing ? HORIZONTAL : PAGE;
+}
+
+void SSD1306::Configure(void)
+{
+    Init_Sequence storage;
+    const Init_Sequence &sequence = Get_Init_Sequence(storage);
+    Write_Commands(sequence.data(), sequence.size());
+    Reset_State(sequence);
+}
+
+void SSD1306::Sleep(void)
+{
+    Write_Command(0xAE);
+}
+
+SSD1306::Resume_Result SSD1306::Resume(void)
+{
+    if (!Needs_Reinitialization())
+    {
+        Write_Command(0xAF);
+        if (last_error == 0)
+        {
+            return RESUMED;
+        }
+    }
+
+    last_error = 0;
+    Configure();
+    Display_On();
+    Update_Screen();
+    isinitialized = last_error == 0;
+    return isinitialized ? REINITIALIZED : RESUME_FAILED;
+}
+
+bool SSD1306::Needs_Reinitialization(void) const
+{
+    if (!isinitialized || last_error != 0)
+    {
+        return true;
+    }
+    return power_probe != nullptr && !power_probe(power_probe_context);
+}
+
+void SSD1306::Set_Power_Probe(bool (*probe)(void *context), void *context)
+{
+    power_probe = probe;
+    power_probe_context = context;
+}
+
+void SSD1306::Clean(void)
+{
+    Fill(BLACK);
+}
+
+void SSD1306::Update_Screen(void)
+{
+    Update_Region(0, 0, width, height);
+}
+
+void SSD1306::Update_Region(uint8_t x, uint8_t y, uint8_t width, uint8_t height)
+{
+    Window window;
+    if (Clip_Region(x, y, width, height, window) && Limit_To_Active_Pages(window))
+    {
+        Write_Window(window);
+    }
+}
+
+bool SSD1306::Enter_Partial_Mode(uint8_t y, uint8_t rows)
+{
+    Window window;
+    if (!Clip_Region(0, y, width, rows, window))
+    {
+        return false;
+    }
+    Set_Partial_State(window);
+
+    uint8_t commands[5];
+    Write_Commands(commands, Partial_Mode_Commands(commands));
+    return true;
+}
+
+void SSD1306::Set_Partial_State(Window window)
+{
+    if (window.first_page == window.last_page) // multiplex ratio can not be lower than 16
+    {
+        if (window.last_page + 1 < height / 8)
+        {
+            window.last_page++;
+        }
+        else
+        {
+            window.first_page--;
+        }
+    }
+    if (!partial)
+    {
+        deferred_pages = 0;
+    }
+    partial = true;
+    partial_first_page = window.first_page;
+    partial_last_page = window.last_page;
+}
+
+void SSD1306::Exit_Partial_Mode(void)
+{
+    if (!partial)
+    {
+        return;
+    }
+    partial = false;
+    uint8_t commands[5];
+    Write_Commands(commands, Partial_Mode_Commands(commands));
+
+    Window window;
+    while (Next_Stale_Window(window))
+    {
+        Write_Window(window);
+    }
+}
+
+bool SSD1306::Is_Partial_Mode(void) const
+{
+    return partial;
+}
+
+uint8_t SSD1306::Partial_Mode_Commands(uint8_t *commands) const
+{
+    uint8_t rows = Scanned_Rows();
+    uint8_t first_row = partial ? uint8_t(partial_first_page * 8) : 0;
+
+    commands[0] = 0xA8; //Set multiplex ratio
+    commands[1] = uint8_t(rows - 1);
+    commands[2] = 0xD3; //Set display offset
+    // COM c shows row c+offset, with remapped scan COM are counted from COM[rows-1]
+    commands[3] = flipped ? uint8_t((64 - first_row) & 0x3F) : uint8_t((height - rows - first_row) & 0x3F);
+    commands[4] = uint8_t(0x40 | first_row); //Set start line
+    return 5;
+}
+
+bool SSD1306::Limit_To_Active_Pages(Window &window)
+{
+    if (!partial)
+    {
+        return true;
+    }
+    for (uint8_t page = window.first_page; page <= window.last_page; page++)
+    {
+        if (page < partial_first_page || page > partial_last_page)
+        {
+            deferred_pages |= uint8_t(1 << page);
+        }
+    }
+    if (window.last_page < partial_first_page || window.first_page > partial_last_page)
+    {
+        return false;
+    }
+    if (window.first_page < partial_first_page)
+    {
+        window.first_page = partial_first_page;
+    }
+    if (window.last_page > partial_last_page)
+    {
+        window.last_page = partial_last_page;
+    }
+    return true;
+}
+
+bool SSD1306::Next_Stale_Window(Window &window)
+{
+    bool found = false;
+    for (uint8_t page = 0; page < height / 8; page++)
+    {
+        // panel can show older content than buffer had when partial mode was entered, so page is always sent
+        bool stale = deferred_pages & (1 << page);
+        deferred_pages &= uint8_t(~(1 << page));
+        if (stale)
+        {
+            if (!found)
+            {
+                window.first_page = page;
+                found = true;
+            }
+            window.last_page = page;
+        }
+        else if (found)
+        {
+            break;
+        }
+    }
+    window.first_column = 0;
+    window.last_column = width - 1;
+    return found;
+}
+
+void SSD1306::Write_Window(const Window &window)
+{
+    Window_Writer writer(*this, window);
+    uint8_t control_byte;
+    const uint8_t *data;
+    uint16_t size;
+    uint8_t attempt = 1;
+    uint32_t backoff = retry.backoff_us;
+    int error = last_error;
+#if SSD1306_STATISTICS
+    uint32_t start = Statistics_Time();
+#endif
+    while (writer.Next(control_byte, data, size))
+    {
+        if (Transfer(control_byte, data, size))
+        {
+            last_error = error; // recovered errors are not reported
+#if SSD1306_STATISTICS
+            if (attempt > 1)
+            {
+                statistics.recoveries++;
+            }
+#endif
+            attempt = 1;
+            backoff = retry.backoff_us;
+        }
+        else if (Prepare_Retry(attempt, backoff))
+        {
+            writer.Rewind(control_byte);
+        }
+        else
+        {
+            writer.Failed(control_byte);
+#if SSD1306_TRACE
+            Trace(control_b_data, nullptr, 0, false);
+#endif
+            return;
+        }
+    }
+#if SSD1306_STATISTICS
+    Record_Frame(start);
+#endif
+#if SSD1306_TRACE
+    Trace(control_b_data, nullptr, 0, true);
+#endif
+    Window_Sent(window);
+}
+
+void SSD1306::Update_Dirty(void)
+{
+    Window window;
+    uint8_t page = 0;
+    while (Next_Dirty_Window(page, window))
+    {
+        page = window.last_page + 1;
+        if (Limit_To_Active_Pages(window))
+        {
+            Write_Window(window);
+        }
+    }
+}
+
+void SSD1306::Take_Snapshot(uint8_t *image) const
+{
+    memcpy(image, buffer.data(), buffer_size);
+}
+
+void SSD1306::Mark_Changes(const uint8_t *shown)
+{
+    for (uint8_t page = 0; page < height / 8; page++)
+    {
+        const uint8_t *now = &buffer[page * width];
+        const uint8_t *before = &shown[page * width];
+        uint8_t first = 0;
+        uint8_t last = uint8_t(width - 1);
+        while (first < width && now[first] == before[first])
+        {
+            first++;
+        }
+        while (last > first && now[last] == before[last])
+        {
+            last--;
+        }
+        dirty_begin[page] = dirty_end[page] = 0;
+        if (first < width)
+        {
+            Mark_Dirty(page, first, last);
+        }
+    }
+}
+
+void SSD1306::Mark_Dirty(const Window &window)
+{
+    for (uint8_t page = window.first_page; page <= window.last_page; page++)
+    {
+        Mark_Dirty(page, window.first_column, window.last_column);
+    }
+}
+
+void SSD1306::Clear_Dirty(const Window &window)
+{
+    for (uint8_t page = window.first_page; page <= window.last_page; page++)
+    {
+        if (window.first_column <= dirty_begin[page] && window.last_column + 1 >= dirty_end[page])
+        {
+            dirty_begin[page] = dirty_end[page] = 0;
+        }
+    }
+}
+
+bool SSD1306::Next_Dirty_Window(uint8_t page, Window &window) const
+{
+    bool found = false;
+    for (; page < height / 8; page++)
+    {
+        if (dirty_begin[page] >= dirty_end[page])
+        {
+            if (found)
+            {
+                break;
+            }
+            continue;
+        }
+        if (!found)
+        {
+            window.first_page = page;
+            window.first_column = dirty_begin[page];
+            window.last_column = uint8_t(dirty_end[page] - 1);
+            found = true;
+        }
+        if (dirty_begin[page] < window.first_column)
+        {
+            window.first_column = dirty_begin[page];
+        }
+        if (dirty_end[page] - 1 > window.last_column)
+        {
+            window.last_column = uint8_t(dirty_end[page] - 1);
+        }
+        window.last_page = page;
+    }
+    return found;
+}
+
+void SSD1306::Set_Retry_Policy(const Retry_Policy &policy)
+{
+    retry = policy;
+    if (retry.attempts == 0)
+    {
+        retry.attempts = 1;
+    }
+}
+
+bool SSD1306::Write_Command(uint8_t command)
+{
+    return Send(control_b_command, &command, 1);
+}
+
+bool SSD1306::Write_Commands(const uint8_t *commands, uint16_t size)
+{
+    return Send(control_b_command, commands, size);
+}
+
+bool SSD1306::Send(uint8_t control_byte, const uint8_t *data, uint16_t size)
+{
+    int error = last_error;
+    uint8_t attempt = 1;
+    uint32_t backoff = retry.backoff_us;
+    while (!Transfer(control_byte, data, size))
+    {
+        if (!Prepare_Retry(attempt, backoff))
+        {
+            return false;
+        }
+    }
+    last_error = error; // recovered errors are not reported
+#if SSD1306_STATISTICS
+    if (attempt > 1)
+    {
+        statistics.recoveries++;
+    }
+#endif
+    return true;
+}
+
+bool SSD1306::Transfer(uint8_t control_byte, const uint8_t *data, uint16_t size)
+{
+#if SSD1306_STATISTICS
+    uint32_t start = Statistics_Time();
+#endif
+#if SSD1306_TRACE
+    Trace_Begin();
+#endif
+    bool succeeded = Transmit(control_byte, data, size);
+#if SSD1306_STATISTICS
+    Record_Transfer(control_byte, succeeded, start);
+#endif
+#if SSD1306_TRACE
+    Trace(control_byte, data, size, succeeded);
+#endif
+    return succeeded;
+}
+
+bool SSD1306::Prepare_Retry(uint8_t &attempt, uint32_t &backoff)
+{
+    if (attempt >= retry.attempts)
+    {
+        return false;
+    }
+    attempt++;
+#if SSD1306_STATISTICS
+    statistics.retries++;
+#endif
+    if (retry.bus_reset != nullptr)
+    {
+        retry.bus_reset(retry.context);
+    }
+    if (retry.delay_us != nullptr)
+    {
+        retry.delay_us(retry.context, backoff);
+    }
+    backoff = (backoff * 2 > retry.max_backoff_us) ? retry.max_backoff_us : backoff * 2;
+    return true;
+}
+
+SSD1306::Window_Writer::Window_Writer(SSD1306 &display, const Window &window) :
+        display(display), window(window), page(window.first_page)
+{
+    display.Clear_Dirty(window);
+
+    uint8_t columns = window.last_column - window.first_column + 1;
+    uint8_t pages = window.last_page - window.first_page + 1;
+
+    if (!Get_Controller_Traits(display.controller).horizontal_addressing)
+    {
+        mode = PAGE;
+    }
+    else if (pages > 1 && columns != display.width
+            && columns * pages <= SSD1306_VERTICAL_SCRATCH_SIZE)
+    {
+        mode = VERTICAL;
+    }
+    else
+    {
+        mode = HORIZONTAL;
+    }
+}
+
+bool SSD1306::Window_Writer::Next(uint8_t &control_byte, const uint8_t *&data,
+        uint16_t &size)
+{
+    if (page > window.last_page)
+    {
+        return false;
+    }
+    transfer_page = page;
+    const Controller_Traits traits = Get_Controller_Traits(display.controller);
+    uint8_t columns = window.last_column - window.first_column + 1;
+    uint8_t column = window.first_column + traits.column_offset;
+
+    if (!commands_sent)
+    {
+        uint8_t n = 0;
+        if (mode == PAGE)
+        {
+            // Page addressing: column pointer has to be set for each page
+            commands[n++] = 0xB0 | page; //Page start address
+            commands[n++] = column & 0x0F; //Lower column start address
+            commands[n++] = 0x10 | (column >> 4); //Higher column start address
+        }
+        else
+        {
+            if (display.addressing != mode)
+            {
+                commands[n++] = 0x20; //Set Memory Addressing Mode
+                commands[n++] = mode;
+                display.addressing = mode;
+            }
+            commands[n++] = 0x21; //Column address
+            commands[n++] = column;
+            commands[n++] = column + columns - 1;
+            commands[n++] = 0x22; //Page address
+            commands[n++] = window.first_page;
+            commands[n++] = window.last_page;
+        }
+        commands_sent = true;
+        control_byte = display.control_b_command;
+        data = commands;
+        size = n;
+        return true;
+    }
+
+    control_byte = display.control_b_data;
+    if (mode == PAGE)
+    {
+        data = &display.buffer[page * display.width + window.first_column];
+        size = columns;
+        page++;
+        commands_sent = false;
+    }
+    else if (mode == HORIZONTAL && columns == display.width)
+    {
+        // whole pages are continuous in buffer
+        data = &display.buffer[page * display.width];
+        size = (window.last_page - page + 1) * display.width;
+        page = window.last_page + 1;
+    }
+    else if (mode == HORIZONTAL)
+    {
+        data = &display.buffer[page * display.width + window.first_column];
+        size = columns;
+        page++;
+    }
+#if SSD1306_VERTICAL_SCRATCH_SIZE > 0
+    else
+    {
+        // Vertical addressing: memory is filled column by column
+        uint16_t n = 0;
+        for (uint8_t c = window.first_column; c <= window.last_column; c++)
+        {
+            for (uint8_t p = window.first_page; p <= window.last_page; p++)
+            {
+                scratch[n++] = display.buffer[p * display.width + c];
+            }
+        }
+        data = scratch;
+        size = n;
+        page = window.last_page + 1;
+    }
+#endif
+    return true;
+}
+
+void SSD1306::Window_Writer::Rewind(uint8_t control_byte)
+{
+    if (control_byte == display.control_b_command)
+    {
+        display.addressing = UNKNOWN;
+    }
+    // part of last transfer could be written, so display pointer is set again
+    window.first_page = transfer_page;
+    page = transfer_page;
+    commands_sent = false;
+}
+
+void SSD1306::Window_Writer::Failed(uint8_t control_byte)
+{
+    if (control_byte == display.control_b_command)
+    {
+        // mode change could be not received
+        display.addressing = UNKNOWN;
+    }
+    // position of display pointer is unknown, so rest of window has to be sent again
+    display.Mark_Dirty(Window { window.first_column, window.last_column, transfer_page, window.last_page });
+    page = window.last_page + 1;
+}
+
+bool SSD1306::Clip_Region(uint8_t x, uint8_t y, uint8_t width, uint8_t height,
+        Window &window) const
+{
+    if (x >= this->width || y >= this->height || width == 0 || height == 0)
+    {
+        return false;
+    }
+    uint8_t last_column = (width > this->width - x) ? this->width - 1 : x + width - 1;
+    uint8_t last_row = (height > this->height - y) ? this->height - 1 : y + height - 1;
+
+    window.first_column = x;
+    window.last_column = last_column;
+    window.first_page = y / 8;
+    window.last_page = last_row / 8;
+    return true;
+}
+
+namespace
+{
+// Buffer is processed by the widest native word, on host additionally by SSE2 registers.
+#if UINTPTR_MAX > 0xFFFFFFFFu
+typedef uint64_t Word;
+#else
+typedef uint32_t Word;
+#endif
+
+// memcpy is compiled to single load/store, and does not break strict aliasing rules
+inline Word Load_Word(const uint8_t *data)
+{
+    Word word;
+    memcpy(&word, data, sizeof(Word));
+    return word;
+}
+
+inline void Store_Word(uint8_t *data, Word word)
+{
+    memcpy(data, &word, sizeof(Word));
+}
+
+// Repeats 4 byte pattern (lowest byte first) in word, independent of endianness
+Word Repeat_Pattern(uint32_t pattern)
+{
+    uint8_t bytes[sizeof(Word)];
+    for (uint8_t i = 0; i < sizeof(Word); i++)
+    {
+        bytes[i] = uint8_t(pattern >> (8 * (i % 4)));
+    }
+    return Load_Word(bytes);
+}
+
+// data has to be word aligned (as SSD1306::buffer is), so stores are not split on cores without unaligned access
+void Fill_Words(uint8_t *data, uint32_t size, Word pattern)
+{
+#if defined(__GNUC__)
+    data = static_cast<uint8_t*>(__builtin_assume_aligned(data, sizeof(Word)));
+#endif
+    uint32_t i = 0;
+#if defined(__SSE2__)
+    Word lanes[16 / sizeof(Word)];
+    for (auto &lane : lanes)
+    {
+        lane = pattern;
+    }
+    const __m128i wide = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes));
+    for (; i + 16 <= size; i += 16)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(data + i), wide);
+    }
+#endif
+    for (; i + sizeof(Word) <= size; i += sizeof(Word))
+    {
+        Store_Word(data + i, pattern);
+    }
+}
+
+void Xor_Bytes(uint8_t *data, uint32_t size, uint8_t mask)
+{
+    uint32_t i = 0;
+    for (; i < size && (uintptr_t(data + i) % sizeof(Word)) != 0; i++)
+    {
+        data[i] ^= mask;
+    }
+#if defined(__SSE2__)
+    const __m128i wide = _mm_set1_epi8(char(mask));
+    for (; i + 16 <= size; i += 16)
+    {
+        __m128i *chunk = reinterpret_cast<__m128i*>(data + i);
+        _mm_storeu_si128(chunk, _mm_xor_si128(_mm_loadu_si128(chunk), wide));
+    }
+#endif
+    const Word word_mask = Repeat_Pattern(mask * 0x01010101u);
+    for (; i + sizeof(Word) <= size; i += sizeof(Word))
+    {
+        Store_Word(data + i, Load_Word(data + i) ^ word_mask);
+    }
+    for (; i < size; i++)
+    {
+        data[i] ^= mask;
+    }
+}
+
+bool Equal_Bytes(const uint8_t *a, const uint8_t *b, uint32_t size)
+{
+    uint32_t i = 0;
+#if defined(__SSE2__)
+    for (; i + 16 <= size; i += 16)
+    {
+        __m128i equal = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)));
+        if (_mm_movemask_epi8(equal) != 0xFFFF)
+        {
+            return false;
+        }
+    }
+#endif
+    for (; i + sizeof(Word) <= size; i += sizeof(Word))
+    {
+        if (Load_Word(a + i) != Load_Word(b + i))
+        {
+            return false;
+        }
+    }
+    for (; i < size; i++)
+    {
+        if (a[i] != b[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Index of first byte from 'from' to 'to'-1 which differs, 'to' if all are equal
+uint8_t First_Difference(const uint8_t *a, const uint8_t *b, uint8_t from, uint8_t to)
+{
+    uint32_t i = from;
+#if defined(__SSE2__)
+    for (; i + 16 <= to; i += 16)
+    {
+        unsigned equal = unsigned(_mm_movemask_epi8(_mm_cmpeq_epi8(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)))));
+        if (equal != 0xFFFF)
+        {
+            return uint8_t(i + __builtin_ctz(~equal));
+        }
+    }
+#endif
+    for (; i + sizeof(Word) <= to; i += sizeof(Word))
+    {
+        if (Load_Word(a + i) != Load_Word(b + i))
+        {
+            break;
+        }
+    }
+    for (; i < to && a[i] == b[i]; i++)
+    {
+    }
+    return uint8_t(i);
+}
+
+// Bits of page byte which belong to rows from first_row to last_row
+uint8_t Page_Mask(uint8_t page, uint8_t first_row, uint8_t last_row)
+{
+    uint8_t mask = 0xFF;
+    if (page == first_row / 8)
+    {
+        mask &= uint8_t(0xFF << (first_row % 8));
+    }
+    if (page == last_row / 8)
+    {
+        mask &= uint8_t(0xFF >> (7 - last_row % 8));
+    }
+    return mask;
+}
+
+const Patterns::PatternDef blank = { { 0, 0, 0, 0, 0, 0, 0, 0 } };
+
+// Display has at most 64 rows, so whole column fits in one word (bit n is row n)
+uint64_t Read_Column(const uint8_t *column, uint8_t first_page, uint8_t last_page)
+{
+    uint64_t bits = 0;
+    for (uint8_t page = first_page; page <= last_page; page++)
+    {
+        bits |= uint64_t(column[page * 128]) << (8 * page);
+    }
+    return bits;
+}
+
+void Write_Column(uint8_t *column, uint8_t first_page, uint8_t last_page, uint64_t bits)
+{
+    for (uint8_t page = first_page; page <= last_page; page++)
+    {
+        column[page * 128] = uint8_t(bits >> (8 * page));
+    }
+}
+
+uint64_t Rows_Mask(int16_t first_row, int16_t rows)
+{
+    return (~uint64_t(0) >> (64 - rows)) << first_row;
+}
+}
+
+void SSD1306::Fill(SSD1306::Color color)
+{
+    if (color == Color::INVERT)
+    {
+        Xor_Bytes(buffer.data(), buffer_size, 0xFF);
+    }
+    else
+    {
+        Fill_Words(buffer.data(), buffer_size, Repeat_Pattern(color * 0x01010101u));
+    }
+    Mark_Dirty(Window { 0, uint8_t(width - 1), 0, uint8_t(height / 8 - 1) });
+}
+
+void SSD1306::Fill_Pattern(uint32_t pattern)
+{
+    Fill_Words(buffer.data(), buffer_size, Repeat_Pattern(pattern));
+    Mark_Dirty(Window { 0, uint8_t(width - 1), 0, uint8_t(height / 8 - 1) });
+}
+
+void SSD1306::Invert_Region(uint8_t x, uint8_t y, uint8_t width, uint8_t height)
+{
+    Window window;
+    if (!Clip_Region(x, y, width, height, window))
+    {
+        return;
+    }
+    uint8_t last_row = (height > this->height - y) ? this->height - 1 : y + height - 1;
+    uint8_t columns = uint8_t(window.last_column - window.first_column + 1);
 
-    Display_On();
-    Clean();
-    Update_Screen();
+    for (uint8_t page = window.first_page; page <= window.last_page; page++)
+    {
+        Xor_Bytes(&buffer[page * this->width + window.first_column], columns, Page_Mask(page, y, last_row));
+    }
+    Mark_Dirty(window);
+}
 
-    if (last_error == 0)
+void SSD1306::Copy_Region(uint8_t x, uint8_t y, uint8_t width, uint8_t height, int16_t to_x,
+        int16_t to_y)
+{
+    if (x >= this->width || y >= this->height)
     {
-        isinitialized = true;
+        return;
     }
-    else
+    // clip source to display, then destination to display
+    int16_t from_x = x;
+    int16_t from_y = y;
+    int16_t columns = (width > this->width - x) ? this->width - x : width;
+    int16_t rows = (height > this->height - y) ? this->height - y : height;
+    if (to_x < 0)
     {
-        isinitialized = false;
+        from_x -= to_x;
+        columns += to_x;
+        to_x = 0;
+    }
+    if (to_y < 0)
+    {
+        from_y -= to_y;
+        rows += to_y;
+        to_y = 0;
+    }
+    columns = (to_x + columns > this->width) ? this->width - to_x : columns;
+    rows = (to_y + rows > this->height) ? this->height - to_y : rows;
+    if (columns <= 0 || rows <= 0)
+    {
+        return;
     }
 
-    return isinitialized;
+    const uint8_t first_page = uint8_t(to_y / 8);
+    const uint8_t last_page = uint8_t((to_y + rows - 1) / 8);
+    if (from_y % 8 == 0 && to_y % 8 == 0 && rows % 8 == 0)
+    {
+        // whole pages are moved, pages are processed in order which does not overwrite source
+        const int16_t shift = int16_t(from_y / 8 - first_page);
+        for (uint8_t i = 0; i <= last_page - first_page; i++)
+        {
+            uint8_t page = (shift < 0) ? uint8_t(last_page - i) : uint8_t(first_page + i);
+            memmove(&buffer[page * this->width + to_x], &buffer[(page + shift) * this->width + from_x],
+                    uint8_t(columns));
+        }
+    }
+    else
+    {
+        // each column is moved as 64-bit word, merged with rows of destination outside of region
+        const uint8_t from_first_page = uint8_t(from_y / 8);
+        const uint8_t from_last_page = uint8_t((from_y + rows - 1) / 8);
+        const uint64_t mask = Rows_Mask(to_y, rows);
+        for (int16_t i = 0; i < columns; i++)
+        {
+            int16_t column = (to_x > from_x) ? int16_t(columns - 1 - i) : i;
+            uint64_t bits = Read_Column(&buffer[from_x + column], from_first_page, from_last_page);
+            bits = (to_y > from_y) ? bits << (to_y - from_y) : bits >> (from_y - to_y);
+            uint8_t *destination = &buffer[to_x + column];
+            uint64_t kept = Read_Column(destination, first_page, last_page) & ~mask;
+            Write_Column(destination, first_page, last_page, kept | (bits & mask));
+        }
+    }
+    Mark_Dirty(Window { uint8_t(to_x), uint8_t(to_x + columns - 1), first_page, last_page });
 }
 
-void SSD1306::Clean(void)
+bool SSD1306::Is_Equal(const uint8_t *image) const
 {
-    Fill(BLACK);
+    return Equal_Bytes(buffer.data(), image, buffer_size);
 }
 
-void SSD1306::Update_Screen(void)
+void SSD1306::Set_Shadow(uint8_t *shadow)
 {
-    Write_Command(0x21); //Column address
-    Write_Command(0x00);
-    Write_Command(127);
-
-    Write_Command(0x22); //Page address
-    Write_Command(0x00);
-    Write_Command((height / 8) - 1);
-
-    Write_Data(buffer);
+    this->shadow = shadow;
 }
 
-void SSD1306::Fill(SSD1306::Color color)
+void SSD1306::Update_Changed(void)
 {
-    if (color == Color::BLACK)
+    if (shadow == nullptr)
+    {
+        Update_Dirty();
+        return;
+    }
+    auto area = [](const Window &w)
+    {
+        return (w.last_column - w.first_column + 1) * (w.last_page - w.first_page + 1);
+    };
+    auto bounding = [](Window a, const Window &b)
     {
-        for (auto &b : buffer)
+        a.first_column = b.first_column < a.first_column ? b.first_column : a.first_column;
+        a.last_column = b.last_column > a.last_column ? b.last_column : a.last_column;
+        a.first_page = b.first_page < a.first_page ? b.first_page : a.first_page;
+        a.last_page = b.last_page > a.last_page ? b.last_page : a.last_page;
+        return a;
+    };
+
+    // comparison replaces tracked changes, afterwards only failed transfers are marked
+    memset(dirty_begin, 0, sizeof(dirty_begin));
+    memset(dirty_end, 0, sizeof(dirty_end));
+
+    Window open[max_changed_windows]; // windows reaching previous page, they can grow down
+    uint8_t open_count = 0;
+    for (uint8_t page = 0; page <= height / 8; page++) // one more pass sends windows reaching last page
+    {
+        Window current[max_changed_windows];
+        uint8_t current_count = 0;
+        bool extended[max_changed_windows] = { };
+        const uint8_t *now = buffer.data() + page * width;
+        const uint8_t *shown = shadow + page * width;
+        uint8_t column = page < height / 8 ? First_Difference(now, shown, 0, width) : width;
+        while (column < width)
+        {
+            Window run = { column, column, page, page };
+            column = First_Difference(now, shown, uint8_t(column + 1), width);
+            while (column < width && column - run.last_column - 1 <= SSD1306_WINDOW_COST)
+            {
+                run.last_column = column;
+                column = First_Difference(now, shown, uint8_t(column + 1), width);
+            }
+            for (uint8_t i = 0; i < open_count; i++)
+            {
+                Window merged = bounding(open[i], run);
+                if (!extended[i] && area(merged) - area(open[i]) - area(run) <= SSD1306_WINDOW_COST)
+                {
+                    extended[i] = true;
+                    run = merged;
+                    break;
+                }
+            }
+            if (current_count < max_changed_windows)
+            {
+                current[current_count++] = run;
+            }
+            else
+            {
+                current[current_count - 1] = bounding(current[current_count - 1], run);
+            }
+        }
+        for (uint8_t i = 0; i < open_count; i++)
         {
-            b = Color::BLACK;
+            if (!extended[i])
+            {
+                Write_Changed(open[i]);
+            }
         }
+        memcpy(open, current, current_count * sizeof(Window));
+        open_count = current_count;
     }
-    else
+
+    // content of display is unknown where sending failed, so it will differ from buffer next time
+    for (uint8_t page = 0; page < height / 8; page++)
     {
-        for (auto &b : buffer)
+        for (uint8_t column = dirty_begin[page]; column < dirty_end[page]; column++)
         {
-            b = Color::WHITE;
+            shadow[page * width + column] = uint8_t(~buffer[page * width + column]);
         }
     }
 }
 
+void SSD1306::Write_Changed(Window window)
+{
+    if (!Limit_To_Active_Pages(window))
+    {
+        return;
+    }
+    for (uint8_t page = window.first_page; page <= window.last_page; page++)
+    {
+        memcpy(&shadow[page * width + window.first_column], &buffer[page * width + window.first_column],
+                window.last_column - window.first_column + 1);
+    }
+    Write_Window(window);
+}
+
 void SSD1306::Write_String(char const *str)
 {
     int i = 0;
@@ -149,11 +1066,125 @@ void SSD1306::Clean_Errors(void)
     last_error = 0;
 }
 
+#if SSD1306_STATISTICS
+const SSD1306::Statistics& SSD1306::Get_Statistics(void) const
+{
+    return statistics;
+}
+
+void SSD1306::Clean_Statistics(void)
+{
+    statistics = Statistics { };
+    window_frames = 0;
+}
+
+void SSD1306::Set_Statistics_Clock(uint32_t (*clock)(void))
+{
+    statistics_clock = clock;
+}
+
+void SSD1306::Record_Transfer(uint8_t control_byte, bool succeeded, uint32_t start)
+{
+    statistics.transfers++;
+    uint32_t latency = Statistics_Time() - start;
+    if (latency > statistics.worst_latency_us)
+    {
+        statistics.worst_latency_us = latency;
+    }
+    if (succeeded)
+    {
+        return;
+    }
+    if (control_byte == control_b_command)
+    {
+        statistics.command_errors++;
+    }
+    else
+    {
+        statistics.data_errors++;
+    }
+    if (last_error == ERROR_TIMEOUT)
+    {
+        statistics.timeouts++;
+    }
+    else if (last_error == ERROR_NACK)
+    {
+        statistics.nacks++;
+    }
+}
+
+void SSD1306::Record_Frame(uint32_t start)
+{
+    statistics.frames++;
+    uint32_t bin = (Statistics_Time() - start) / SSD1306_STATISTICS_BIN_US;
+    if (bin >= SSD1306_STATISTICS_BINS)
+    {
+        bin = SSD1306_STATISTICS_BINS - 1;
+    }
+    if (++window_frames >= SSD1306_STATISTICS_WINDOW)
+    {
+        window_frames = 0;
+        for (auto &count : statistics.frame_time)
+        {
+            count /= 2;
+        }
+    }
+    statistics.frame_time[bin]++;
+}
+#endif
+
+void SSD1306::Transfer_Complete(int error)
+{
+    if (error != 0)
+    {
+        last_error = error;
+    }
+#if SSD1306_STATISTICS
+    Record_Transfer(transfer_control, error == 0, transfer_start);
+#endif
+#if SSD1306_TRACE
+    Trace(trace_control, trace_data, trace_size, error == 0);
+#endif
+    if (transfer_callback != nullptr)
+    {
+        transfer_callback(transfer_context, error);
+    }
+}
+
+void SSD1306::Set_Transfer_Callback(void (*callback)(void *context, int error),
+        void *context)
+{
+    transfer_callback = callback;
+    transfer_context = context;
+}
+
+void SSD1306::Set_Update_Hook(void (*hook)(void *context, const uint8_t *buffer, uint8_t first_column,
+        uint8_t last_column, uint8_t first_page, uint8_t last_page), void *context)
+{
+    update_hook = hook;
+    update_context = context;
+}
+
+#if SSD1306_TRACE
+void SSD1306::Set_Trace_Hook(void (*hook)(void *context, uint8_t control_byte, const uint8_t *data,
+        uint16_t size, bool succeeded), void *context, void (*begin)(void *context))
+{
+    trace_hook = hook;
+    trace_begin = begin;
+    trace_context = context;
+}
+#endif
+
 void SSD1306::Write_Char(char chr, SSD1306::Color color)
 {
+    uint8_t code = uint8_t(chr);
+    if (code < ' ' || code > '~')
+    {
+        code = '?'; // fonts contain only printable ASCII characters
+    }
     for (uint8_t y = 0; y < font.FontHeight; y++)
     {
-        uint16_t row = font.data[(chr - 32) * font.FontHeight + y];
+        uint16_t row = font.data[(code - ' ') * font.FontHeight + y];
         for (uint8_t x = 0; x < font.FontWidth; x++)
         {
             if (color == Color::BLACK)
@@ -180,7 +1211,8 @@ void SSD1306::Write_Char(char chr, SSD1306::Color color)
             }
         }
     }
-    Coordinates.X += font.FontWidth;
+    // cursor stops behind right edge, so long text does not wrap around to the left
+    Coordinates.X = uint8_t(Coordinates.X + font.FontWidth > width ? width : Coordinates.X + font.FontWidth);
 }
 
 void SSD1306::Set_Font_size(Fonts::FontDef font)
@@ -188,6 +1220,55 @@ void SSD1306::Set_Font_size(Fonts::FontDef font)
     this->font = font;
 }
 
+Fonts::FontDef SSD1306::Get_Font_size(void) const
+{
+    return font;
+}
+
+void SSD1306::Set_Clock(uint8_t divide, uint8_t oscillator)
+{
+    clock = Make_Clock(divide, oscillator);
+    Write_Command(0xD5);
+    Write_Command(clock);
+}
+
+uint8_t SSD1306::Make_Clock(uint8_t divide, uint8_t oscillator)
+{
+    if (divide < 1)
+    {
+        divide = 1;
+    }
+    else if (divide > 16)
+    {
+        divide = 16;
+    }
+    if (oscillator > 15)
+    {
+        oscillator = 15;
+    }
+    return uint8_t((oscillator << 4) | (divide - 1));
+}
+
+uint32_t SSD1306::Get_Frame_Period_Us(void) const
+{
+    return Frame_Period_Us(clock, precharge, Scanned_Rows());
+}
+
+bool SSD1306::Set_Start_Line(uint8_t line)
+{
+    if (partial)
+    {
+        return false;
+    }
+    Write_Command(uint8_t(0x40 | (line & 0x3F)));
+    return true;
+}
+
+uint8_t SSD1306::Get_Height(void) const
+{
+    return height;
+}
+
 void SSD1306::Set_Brightness(uint8_t brightness)
 {
     Write_Command(0x81);
@@ -205,46 +1286,245 @@ void SSD1306::Draw_Pixel(uint8_t x, uint8_t y, SSD1306::Color c)
     if (c == WHITE)
     {
         buffer[x + width * (y / 8)] |= uint8_t(1 << (y % 8));
+        Mark_Dirty(y / 8, x, x);
+    }
+    else if (c == INVERT)
+    {
+        buffer[x + width * (y / 8)] ^= uint8_t(1 << (y % 8));
+        Mark_Dirty(y / 8, x, x);
     }
     else
     {
         buffer[x + width * (y / 8)] &= uint8_t(~ (1 << (y % 8)));
+        Mark_Dirty(y / 8, x, x);
     }
 }
 
 void SSD1306::Draw_Line_H(uint8_t x, uint8_t y, uint8_t width, SSD1306::Color c)
 {
-    for (uint8_t i = 0; i < width; i++)
+    // 16-bit position, so line crossing right edge does not wrap around
+    for (uint16_t i = x; i < x + width && i < this->width; i++)
     {
-        Draw_Pixel(x + i, y, c);
+        Draw_Pixel(uint8_t(i), y, c);
     }
 }
 
 void SSD1306::Draw_Line_V(uint8_t x, uint8_t y, uint8_t height,
         SSD1306::Color c)
 {
-    for (uint8_t i = 0; i < height; i++)
+    for (uint16_t i = y; i < y + height && i < this->height; i++)
     {
-        Draw_Pixel(x, y + i, c);
+        Draw_Pixel(x, uint8_t(i), c);
     }
 }
 
 void SSD1306::Draw_Square(uint8_t x, uint8_t y, uint8_t x2, uint8_t y2,
         SSD1306::Color c)
 {
-    Draw_Line_H(x, y, (uint8_t) (x2 - x + 1), c);
-    Draw_Line_H(x, y2, (uint8_t) (x2 - x + 1), c);
+    if (x2 < x)
+    {
+        uint8_t swap = x;
+        x = x2;
+        x2 = swap;
+    }
+    if (y2 < y)
+    {
+        uint8_t swap = y;
+        y = y2;
+        y2 = swap;
+    }
+    // every pixel is drawn once, so INVERT does not cancel out on corners
+    for (uint16_t i = x; i <= x2 && i < width; i++)
+    {
+        Draw_Pixel(uint8_t(i), y, c);
+        if (y2 != y)
+        {
+            Draw_Pixel(uint8_t(i), y2, c);
+        }
+    }
+    for (uint16_t i = y + 1; i < y2 && i < height; i++)
+    {
+        Draw_Pixel(x, uint8_t(i), c);
+        if (x2 != x)
+        {
+            Draw_Pixel(x2, uint8_t(i), c);
+        }
+    }
+}
+
+void SSD1306::Fill_Rectangle(uint8_t x, uint8_t y, uint8_t width, uint8_t height,
+        SSD1306::Color c)
+{
+    if (c == Color::INVERT)
+    {
+        Invert_Region(x, y, width, height);
+    }
+    else
+    {
+        Fill_Rectangle(x, y, width, height, Brush_Of(c));
+    }
+}
+
+void SSD1306::Fill_Rectangle(uint8_t x, uint8_t y, uint8_t width, uint8_t height,
+        const Patterns::PatternDef &pattern)
+{
+    Fill_Rectangle(x, y, width, height, Brush { pattern, false });
+}
+
+void SSD1306::Fill_Rectangle(uint8_t x, uint8_t y, uint8_t width, uint8_t height,
+        const Brush &brush)
+{
+    Window window;
+    if (!Clip_Region(x, y, width, height, window))
+    {
+        return;
+    }
+    uint8_t last_row = (height > this->height - y) ? this->height - 1 : y + height - 1;
+
+    for (uint8_t page = window.first_page; page <= window.last_page; page++)
+    {
+        const uint8_t mask = Page_Mask(page, y, last_row);
+        uint8_t *bytes = &buffer[page * this->width];
+        for (uint8_t column = window.first_column; column <= window.last_column; column++)
+        {
+            const uint8_t bits = brush.pattern.Columns[column % 8] & mask;
+            bytes[column] = brush.invert ? uint8_t(bytes[column] ^ bits) : uint8_t((bytes[column] & ~mask) | bits);
+        }
+    }
+    Mark_Dirty(window);
+}
+
+void SSD1306::Fill_Circle(uint8_t x, uint8_t y, uint8_t radius, SSD1306::Color c)
+{
+    Fill_Circle(x, y, radius, Brush_Of(c));
+}
+
+void SSD1306::Fill_Circle(uint8_t x, uint8_t y, uint8_t radius,
+        const Patterns::PatternDef &pattern)
+{
+    Fill_Circle(x, y, radius, Brush { pattern, false });
+}
+
+void SSD1306::Fill_Circle(uint8_t x, uint8_t y, uint8_t radius, const Brush &brush)
+{
+    // columns are filled from center outwards, half height only decreases
+    int16_t half_height = radius;
+    for (int16_t dx = 0; dx <= radius; dx++)
+    {
+        while (half_height * half_height + dx * dx > radius * radius)
+        {
+            half_height--;
+        }
+        Fill_Column(x + dx, y - half_height, y + half_height, brush);
+        if (dx != 0)
+        {
+            Fill_Column(x - dx, y - half_height, y + half_height, brush);
+        }
+    }
+}
+
+void SSD1306::Fill_Polygon(const SSD1306::Point *points, uint8_t count, SSD1306::Color c)
+{
+    Fill_Polygon(points, count, Brush_Of(c));
+}
+
+void SSD1306::Fill_Polygon(const SSD1306::Point *points, uint8_t count,
+        const Patterns::PatternDef &pattern)
+{
+    Fill_Polygon(points, count, Brush { pattern, false });
+}
+
+void SSD1306::Fill_Polygon(const SSD1306::Point *points, uint8_t count, const Brush &brush)
+{
+    if (count < 3 || count > SSD1306_POLYGON_MAX_POINTS)
+    {
+        return;
+    }
+    int16_t min_x = points[0].x;
+    int16_t max_x = points[0].x;
+    for (uint8_t i = 1; i < count; i++)
+    {
+        min_x = (points[i].x < min_x) ? points[i].x : min_x;
+        max_x = (points[i].x > max_x) ? points[i].x : max_x;
+    }
+    min_x = (min_x < 0) ? 0 : min_x;
+    max_x = (max_x > width) ? width : max_x;
+
+    // display is scanned by columns (matching layout of buffer), edges are crossed at center
+    // of column; rows are in 1/256 of pixel
+    int32_t crossings[SSD1306_POLYGON_MAX_POINTS];
+    for (int16_t x = min_x; x < max_x; x++)
+    {
+        uint8_t found = 0;
+        for (uint8_t i = 0; i < count; i++)
+        {
+            const Point &a = points[i];
+            const Point &b = points[(i + 1) % count];
+            if ((a.x <= x && b.x > x) || (b.x <= x && a.x > x))
+            {
+                int64_t numerator = int64_t(2 * (x - a.x) + 1) * (b.y - a.y) * 256;
+                crossings[found++] = a.y * 256 + int32_t(numerator / (2 * (b.x - a.x)));
+            }
+        }
+        for (uint8_t i = 1; i < found; i++) // insertion sort, there are only few crossings
+        {
+            int32_t crossing = crossings[i];
+            uint8_t j = i;
+            for (; j > 0 && crossings[j - 1] > crossing; j--)
+            {
+                crossings[j] = crossings[j - 1];
+            }
+            crossings[j] = crossing;
+        }
+        for (uint8_t i = 0; i + 1 < found; i += 2)
+        {
+            // rows whose centers are between crossings
+            int32_t first_row = (crossings[i] - 128 + 255) >> 8;
+            int32_t last_row = ((crossings[i + 1] - 128 + 255) >> 8) - 1;
+            first_row = (first_row < 0) ? 0 : first_row;
+            last_row = (last_row >= height) ? height - 1 : last_row;
+            Fill_Column(x, int16_t(first_row), int16_t(last_row), brush);
+        }
+    }
+}
+
+SSD1306::Brush SSD1306::Brush_Of(SSD1306::Color color)
+{
+    return Brush { (color == Color::BLACK) ? blank : Patterns::solid, color == Color::INVERT };
+}
 
-    Draw_Line_V(x, y, (uint8_t) (y2 - y + 1), c);
-    Draw_Line_V(x2, y, (uint8_t) (y2 - y + 1), c);
+void SSD1306::Fill_Column(int16_t x, int16_t first_row, int16_t last_row, const Brush &brush)
+{
+    if (x < 0 || x >= width)
+    {
+        return;
+    }
+    first_row = (first_row < 0) ? 0 : first_row;
+    last_row = (last_row >= height) ? height - 1 : last_row;
+    if (first_row > last_row)
+    {
+        return;
+    }
+    const uint8_t column = brush.pattern.Columns[x % 8];
+    for (uint8_t page = first_row / 8; page <= last_row / 8; page++)
+    {
+        const uint8_t mask = Page_Mask(page, uint8_t(first_row), uint8_t(last_row));
+        const uint8_t bits = column & mask;
+        uint8_t &byte = buffer[x + width * page];
+        byte = brush.invert ? uint8_t(byte ^ bits) : uint8_t((byte & ~mask) | bits);
+        Mark_Dirty(page, uint8_t(x), uint8_t(x));
+    }
 }
 
 void SSD1306::Draw_Waveform(uint8_t x, uint8_t y, uint8_t *buffer, uint8_t size,
         SSD1306::Color c)
 {
-    for (uint8_t i = 0; i < size; i++)
+    for (uint8_t i = 0; i < size && x + i < width; i++)
     {
-        Draw_Pixel(i + x, y - buffer[i], c);
+        if (buffer[i] <= y) // points above top edge are skipped instead of wrapping around
+        {
+            Draw_Pixel(uint8_t(x + i), uint8_t(y - buffer[i]), c);
+        }
     }
 }
 
@@ -260,6 +1540,7 @@ void SSD1306::Display_On(void)
 
 void SSD1306::Flip_Screen(bool flipped)
 {
+    this->flipped = flipped;
     if (flipped == false)
     {
         Write_Command(0xC8); //Set COM Output Scan Direction
@@ -268,6 +1549,12 @@ void SSD1306::Flip_Screen(bool flipped)
     {
         Write_Command(0xC0);
     }
+    if (partial)
+    {
+        uint8_t commands[5];
+        Partial_Mode_Commands(commands);
+        Write_Commands(&commands[2], 2); //display offset depends on scan direction
+    }
 }
 
 void SSD1306::Invert_Colors(bool inverted)
@@ -289,6 +1576,35 @@ void SSD1306::Draw_Image(const uint8_t *image)
     {
         buffer[i] = image[i];
     }
+    Mark_Dirty(Window { 0, uint8_t(width - 1), 0, uint8_t(height / 8 - 1) });
+}
+
+void SSD1306::Draw_Image_Region(const uint8_t *image, uint8_t x, uint8_t y, uint8_t width,
+        uint8_t height)
+{
+    Window window;
+    if (!Clip_Region(x, y, width, height, window))
+    {
+        return;
+    }
+    uint8_t last_row = (height > this->height - y) ? this->height - 1 : y + height - 1;
+    uint8_t columns = uint8_t(window.last_column - window.first_column + 1);
+
+    for (uint8_t page = window.first_page; page <= window.last_page; page++)
+    {
+        const uint8_t mask = Page_Mask(page, y, last_row);
+        const uint32_t offset = page * this->width + window.first_column;
+        if (mask == 0xFF)
+        {
+            memcpy(&buffer[offset], &image[offset], columns);
+            continue;
+        }
+        for (uint32_t i = offset; i < offset + columns; i++)
+        {
+            buffer[i] = uint8_t((buffer[i] & ~mask) | (image[i] & mask));
+        }
+    }
+    Mark_Dirty(window);
 }
 
 void SSD1306::Set_Cursor(uint8_t x, uint8_t y)
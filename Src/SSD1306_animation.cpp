@@ -0,0 +1,222 @@
+/**
+ ******************************************************************************
+ * @file    SSD1306_animation.cpp
+ * @author  agent
+ * @date    17.10.2026
+ * @brief   Keyframe animation scheduler for OLED display
+ ******************************************************************************
+ * @attention
+ * <h2><center>&copy; COPYRIGHT(c) 2026 agent </center></h2>
+ *
+ *Permission is hereby granted, free of charge,
+ *to any person obtaining a copy of this software and associated documentation files
+ *(the "Software"), to deal in the Software without restriction,
+ *including without limitation the rights to use, copy, modify,
+ *merge, publish, distribute, sublicense, and/or sell copies of
+ *the Software, and to permit persons to whom the Software is furnished to do so,
+ *subject to the following conditions:
+ *
+ *The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ *THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ *INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ *PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ *FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************************************
+ */
+
+#include <stdint.h>
+#include "SSD1306_animation.hpp"
+
+SSD1306_Animator::SSD1306_Animator(SSD1306 &display, uint32_t (*time_source)(void)) :
+        oled(display), now(time_source)
+{
+}
+
+int8_t SSD1306_Animator::Start(const Animation &animation)
+{
+    if (animation.draw == nullptr || animation.keyframes == nullptr || animation.count == 0)
+    {
+        return -1;
+    }
+    for (int8_t i = 0; i < SSD1306_ANIMATION_SLOTS; i++)
+    {
+        Slot &slot = slots[i];
+        if (!slot.used)
+        {
+            slot.animation = animation;
+            slot.start = now();
+            slot.used = true;
+            slot.drawn = false;
+            slot.ended = false;
+            slot.stopping = false;
+            return i;
+        }
+    }
+    return -1;
+}
+
+void SSD1306_Animator::Stop(int8_t slot)
+{
+    if (slot >= 0 && slot < SSD1306_ANIMATION_SLOTS && slots[slot].used)
+    {
+        slots[slot].stopping = true;
+    }
+}
+
+bool SSD1306_Animator::Is_Running(int8_t slot) const
+{
+    return slot >= 0 && slot < SSD1306_ANIMATION_SLOTS && slots[slot].used && !slots[slot].ended
+            && !slots[slot].stopping;
+}
+
+bool SSD1306_Animator::Tick(void)
+{
+    const uint32_t time = now();
+    Bounds changed = { INT16_MAX, INT16_MAX, INT16_MIN, INT16_MIN };
+    bool redraw[SSD1306_ANIMATION_SLOTS] = { };
+
+    // objects which moved, changed frame or were stopped are cleared from their old place
+    for (uint8_t i = 0; i < SSD1306_ANIMATION_SLOTS; i++)
+    {
+        Slot &slot = slots[i];
+        if (!slot.used)
+        {
+            continue;
+        }
+        // ended animation stays at its last keyframe until it is stopped
+        Keyframe state = { 0, slot.x, slot.y, slot.frame };
+        if (!slot.stopping && !slot.ended)
+        {
+            slot.ended = !State_At(slot.animation, uint32_t(time - slot.start), state);
+        }
+        bool moved = !slot.stopping
+                && (!slot.drawn || state.x != slot.x || state.y != slot.y || state.frame != slot.frame);
+        if (slot.drawn && (moved || slot.stopping))
+        {
+            Bounds bounds = Bounds_Of(slot);
+            Clear(bounds);
+            Join(changed, bounds);
+        }
+        if (moved)
+        {
+            slot.x = state.x;
+            slot.y = state.y;
+            slot.frame = state.frame;
+            Join(changed, Bounds_Of(slot));
+            redraw[i] = true;
+        }
+    }
+
+    // changed objects are drawn together with others which could be partially cleared
+    for (uint8_t i = 0; i < SSD1306_ANIMATION_SLOTS; i++)
+    {
+        Slot &slot = slots[i];
+        if (!slot.used || slot.stopping)
+        {
+            continue;
+        }
+        if (redraw[i] || Overlap(Bounds_Of(slot), changed))
+        {
+            slot.animation.draw(slot.animation.context, oled, slot.x, slot.y, slot.frame);
+            slot.drawn = true;
+        }
+    }
+    for (uint8_t i = 0; i < SSD1306_ANIMATION_SLOTS; i++)
+    {
+        if (slots[i].stopping)
+        {
+            slots[i].used = false;
+        }
+    }
+
+    Region region;
+    if (!Clip(changed, region))
+    {
+        return false;
+    }
+    oled.Update_Region(region.x, region.y, region.width, region.height);
+    last_region = region;
+    return true;
+}
+
+const SSD1306_Animator::Region& SSD1306_Animator::Get_Last_Region(void) const
+{
+    return last_region;
+}
+
+bool SSD1306_Animator::State_At(const Animation &animation, uint32_t elapsed, Keyframe &state)
+{
+    const Keyframe *keyframes = animation.keyframes;
+    const uint32_t end = keyframes[animation.count - 1].time_us;
+    if (animation.loop && end > 0)
+    {
+        elapsed %= end;
+    }
+    else if (!animation.loop && elapsed >= end)
+    {
+        state = keyframes[animation.count - 1];
+        return false;
+    }
+
+    uint8_t i = 0;
+    while (i + 1 < animation.count && keyframes[i + 1].time_us <= elapsed)
+    {
+        i++;
+    }
+    state = keyframes[i];
+    if (i + 1 < animation.count)
+    {
+        const Keyframe &next = keyframes[i + 1];
+        const uint32_t span = next.time_us - keyframes[i].time_us;
+        const uint32_t passed = elapsed - keyframes[i].time_us;
+        state.x = int16_t(state.x + int64_t(next.x - state.x) * passed / span);
+        state.y = int16_t(state.y + int64_t(next.y - state.y) * passed / span);
+    }
+    return true;
+}
+
+SSD1306_Animator::Bounds SSD1306_Animator::Bounds_Of(const Slot &slot)
+{
+    return Bounds { slot.x, slot.y, int16_t(slot.x + slot.animation.width),
+            int16_t(slot.y + slot.animation.height) };
+}
+
+bool SSD1306_Animator::Overlap(const Bounds &a, const Bounds &b)
+{
+    return a.left < b.right && b.left < a.right && a.top < b.bottom && b.top < a.bottom;
+}
+
+void SSD1306_Animator::Join(Bounds &total, const Bounds &bounds)
+{
+    total.left = (bounds.left < total.left) ? bounds.left : total.left;
+    total.top = (bounds.top < total.top) ? bounds.top : total.top;
+    total.right = (bounds.right > total.right) ? bounds.right : total.right;
+    total.bottom = (bounds.bottom > total.bottom) ? bounds.bottom : total.bottom;
+}
+
+bool SSD1306_Animator::Clip(const Bounds &bounds, Region &region) const
+{
+    const int16_t left = (bounds.left < 0) ? 0 : bounds.left;
+    const int16_t top = (bounds.top < 0) ? 0 : bounds.top;
+    const int16_t right = (bounds.right > 128) ? 128 : bounds.right;
+    const int16_t bottom = (bounds.bottom > oled.Get_Height()) ? oled.Get_Height() : bounds.bottom;
+    if (left >= right || top >= bottom)
+    {
+        return false;
+    }
+    region = Region { uint8_t(left), uint8_t(top), uint8_t(right - left), uint8_t(bottom - top) };
+    return true;
+}
+
+void SSD1306_Animator::Clear(const Bounds &bounds)
+{
+    Region region;
+    if (Clip(bounds, region))
+    {
+        oled.Fill_Rectangle(region.x, region.y, region.width, region.height, SSD1306::BLACK);
+    }
+}
@@ -0,0 +1,424 @@
+/**
+ ******************************************************************************
+ * @file    SSD1306_async.cpp
+ * @author  agent
+ * @date    17.10.2026
+ * @brief   Awaitable (C++20 coroutines) interface for OLED display
+ ******************************************************************************
+ * @attention
+ * <h2><center>&copy; COPYRIGHT(c) 2026 agent </center></h2>
+ *
+ *Permission is hereby granted, free of charge,
+ *to any person obtaining a copy of this software and associated documentation files
+ *(the "Software"), to deal in the Software without restriction,
+ *including without limitation the rights to use, copy, modify,
+ *merge, publish, distribute, sublicense, and/or sell copies of
+ *the Software, and to permit persons to whom the Software is furnished to do so,
+ *subject to the following conditions:
+ *
+ *The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ *THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ *INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ *PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ *FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************************************
+ */
+
+// Compiled only when C++20 coroutines are available, so the rest of library can be used with older standards
+#if defined(__cpp_impl_coroutine)
+
+#include <stdint.h>
+#include <array>
+#include <atomic>
+#include <exception>
+#include "SSD1306_async.hpp"
+
+alignas(max_align_t) uint8_t SSD1306_Async::Frame_Arena::memory[SSD1306_ASYNC_FRAMES][SSD1306_ASYNC_FRAME_SIZE];
+uint32_t SSD1306_Async::Frame_Arena::used = 0;
+
+static_assert(SSD1306_ASYNC_FRAMES <= 32, "SSD1306_ASYNC_FRAMES can not exceed 32");
+
+void *SSD1306_Async::Frame_Arena::Allocate(size_t size) noexcept
+{
+    if (size > SSD1306_ASYNC_FRAME_SIZE)
+    {
+        return nullptr;
+    }
+    for (uint8_t i = 0; i < SSD1306_ASYNC_FRAMES; i++)
+    {
+        if ((used & (1UL << i)) == 0)
+        {
+            used |= (1UL << i);
+            return memory[i];
+        }
+    }
+    return nullptr;
+}
+
+void SSD1306_Async::Frame_Arena::Free(void *frame) noexcept
+{
+    for (uint8_t i = 0; i < SSD1306_ASYNC_FRAMES; i++)
+    {
+        if (frame == memory[i])
+        {
+            used &= ~(1UL << i);
+            return;
+        }
+    }
+}
+
+uint8_t SSD1306_Async::Frame_Arena::Frames_In_Use(void) noexcept
+{
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < SSD1306_ASYNC_FRAMES; i++)
+    {
+        if (used & (1UL << i))
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+bool SSD1306_Async::Executor::Start(Task &task)
+{
+    if (!task.handle || task.handle.done())
+    {
+        return false;
+    }
+    // Post is used by interrupt, so task goes to separate queue instead of sharing head with it
+    uint8_t next = (started_head + 1) % (SSD1306_ASYNC_QUEUE_SIZE + 1);
+    if (next == started_tail)
+    {
+        return false;
+    }
+    started[started_head] = task.handle;
+    started_head = next;
+    return true;
+}
+
+bool SSD1306_Async::Executor::Post(std::coroutine_handle<> handle)
+{
+    uint8_t next = (head + 1) % (SSD1306_ASYNC_QUEUE_SIZE + 1);
+    if (next == tail)
+    {
+        return false;
+    }
+    queue[head] = handle;
+    std::atomic_signal_fence(std::memory_order_release); // handle has to be stored before it is published
+    head = next;
+    return true;
+}
+
+uint32_t SSD1306_Async::Executor::Run(void)
+{
+    uint32_t resumed = 0;
+    while (started_tail != started_head || tail != head)
+    {
+        std::coroutine_handle<> handle;
+        if (started_tail != started_head)
+        {
+            handle = started[started_tail];
+            started_tail = (started_tail + 1) % (SSD1306_ASYNC_QUEUE_SIZE + 1);
+        }
+        else
+        {
+            std::atomic_signal_fence(std::memory_order_acquire);
+            handle = queue[tail];
+            tail = (tail + 1) % (SSD1306_ASYNC_QUEUE_SIZE + 1);
+        }
+        handle.resume();
+        resumed++;
+    }
+    return resumed;
+}
+
+bool SSD1306_Async::Executor::Is_Idle(void) const
+{
+    return started_tail == started_head && tail == head;
+}
+
+void SSD1306_Async::Task::promise_type::unhandled_exception(void) noexcept
+{
+    std::terminate();
+}
+
+SSD1306_Async::Task& SSD1306_Async::Task::operator=(Task &&other) noexcept
+{
+    if (this != &other)
+    {
+        if (handle)
+        {
+            handle.destroy();
+        }
+        handle = other.handle;
+        other.handle = nullptr;
+    }
+    return *this;
+}
+
+SSD1306_Async::Task::~Task()
+{
+    if (handle)
+    {
+        handle.destroy();
+    }
+}
+
+SSD1306_Async::SSD1306_Async(SSD1306 &display, Executor &executor) :
+        oled(display), executor(executor)
+{
+    oled.Set_Transfer_Callback(On_Transfer_Complete, this);
+}
+
+SSD1306_Async::~SSD1306_Async()
+{
+    oled.Set_Transfer_Callback(nullptr, nullptr);
+}
+
+bool SSD1306_Async::Transfer_Awaiter::await_suspend(
+        std::coroutine_handle<> handle) noexcept
+{
+    if (self.waiting)
+    {
+        // other transfer is in progress
+        self.transfer_error = -1;
+        return false;
+    }
+    self.transfer_error = 0;
+    self.waiting = handle;
+#if SSD1306_STATISTICS
+    self.oled.transfer_start = self.oled.Statistics_Time();
+    self.oled.transfer_control = control_byte;
+#endif
+#if SSD1306_TRACE
+    self.oled.trace_control = control_byte;
+    self.oled.trace_data = data;
+    self.oled.trace_size = size;
+    self.oled.Trace_Begin();
+#endif
+    if (!self.oled.Start_Transfer(control_byte, data, size))
+    {
+        self.waiting = nullptr;
+        self.transfer_error = self.oled.last_error != 0 ? self.oled.last_error : -1;
+#if SSD1306_STATISTICS
+        self.oled.Record_Transfer(control_byte, false, self.oled.transfer_start);
+#endif
+#if SSD1306_TRACE
+        self.oled.Trace(control_byte, data, size, false);
+#endif
+        return false;
+    }
+    return true;
+}
+
+void SSD1306_Async::On_Transfer_Complete(void *context, int error)
+{
+    SSD1306_Async *self = static_cast<SSD1306_Async*>(context);
+    std::coroutine_handle<> handle = self->waiting;
+    if (!handle)
+    {
+        return;
+    }
+    self->transfer_error = error;
+    self->waiting = nullptr;
+    self->executor.Post(handle);
+}
+
+SSD1306_Async::Task SSD1306_Async::Initialize(void)
+{
+    bool ok = co_await Configure();
+    ok = co_await Display_On() && ok;
+
+    oled.Clean();
+    ok = co_await Update_Screen() && ok;
+
+    oled.isinitialized = ok;
+    co_return ok;
+}
+
+SSD1306_Async::Task SSD1306_Async::Configure(void)
+{
+    SSD1306::Init_Sequence storage;
+    const SSD1306::Init_Sequence &sequence = oled.Get_Init_Sequence(storage);
+    bool ok = co_await Write_Commands(sequence.data(), sequence.size());
+    oled.Reset_State(sequence);
+    co_return ok;
+}
+
+SSD1306_Async::Task SSD1306_Async::Sleep(void)
+{
+    const uint8_t command = 0xAE;
+    co_return co_await Write_Commands(&command, 1);
+}
+
+SSD1306_Async::Task SSD1306_Async::Resume(void)
+{
+    if (!oled.Needs_Reinitialization() && co_await Display_On())
+    {
+        co_return true;
+    }
+
+    oled.last_error = 0;
+    bool ok = co_await Configure();
+    ok = co_await Display_On() && ok;
+    ok = co_await Update_Screen() && ok;
+    oled.isinitialized = ok;
+    co_return ok;
+}
+
+SSD1306_Async::Task SSD1306_Async::Update_Screen(void)
+{
+    co_return co_await Update_Region(0, 0, oled.width, oled.height);
+}
+
+SSD1306_Async::Task SSD1306_Async::Update_Region(uint8_t x, uint8_t y,
+        uint8_t width, uint8_t height)
+{
+    SSD1306::Window window;
+    if (!oled.Clip_Region(x, y, width, height, window) || !oled.Limit_To_Active_Pages(window))
+    {
+        co_return true;
+    }
+    co_return co_await Write_Window(window);
+}
+
+SSD1306_Async::Task SSD1306_Async::Enter_Partial_Mode(uint8_t y, uint8_t rows)
+{
+    SSD1306::Window window;
+    if (!oled.Clip_Region(0, y, oled.width, rows, window))
+    {
+        co_return false;
+    }
+    uint8_t commands[5];
+    oled.Set_Partial_State(window);
+    co_return co_await Write_Commands(commands, oled.Partial_Mode_Commands(commands));
+}
+
+SSD1306_Async::Task SSD1306_Async::Exit_Partial_Mode(void)
+{
+    if (!oled.partial)
+    {
+        co_return true;
+    }
+    oled.partial = false;
+    uint8_t commands[5];
+    bool ok = co_await Write_Commands(commands, oled.Partial_Mode_Commands(commands));
+
+    SSD1306::Window window;
+    while (ok && oled.Next_Stale_Window(window))
+    {
+        ok = co_await Write_Window(window);
+    }
+    co_return ok;
+}
+
+SSD1306_Async::Task SSD1306_Async::Write_Window(SSD1306::Window window)
+{
+    SSD1306::Window_Writer writer(oled, window);
+    uint8_t control_byte;
+    const uint8_t *data;
+    uint16_t size;
+    bool ok = true;
+    uint8_t attempt = 1;
+    uint32_t backoff = oled.retry.backoff_us;
+    int error = oled.last_error;
+#if SSD1306_STATISTICS
+    uint32_t start = oled.Statistics_Time();
+#endif
+    while (ok && writer.Next(control_byte, data, size))
+    {
+        if (co_await Transfer_Awaiter { *this, control_byte, data, size })
+        {
+            oled.last_error = error; // recovered errors are not reported
+#if SSD1306_STATISTICS
+            if (attempt > 1)
+            {
+                oled.statistics.recoveries++;
+            }
+#endif
+            attempt = 1;
+            backoff = oled.retry.backoff_us;
+        }
+        else if (oled.Prepare_Retry(attempt, backoff))
+        {
+            writer.Rewind(control_byte);
+        }
+        else
+        {
+            writer.Failed(control_byte);
+            ok = false;
+        }
+    }
+#if SSD1306_STATISTICS
+    if (ok)
+    {
+        oled.Record_Frame(start);
+    }
+#endif
+#if SSD1306_TRACE
+    oled.Trace(oled.control_b_data, nullptr, 0, ok);
+#endif
+    if (ok)
+    {
+        oled.Window_Sent(window);
+    }
+    co_return ok;
+}
+
+SSD1306_Async::Task SSD1306_Async::Display_Off(void)
+{
+    const uint8_t command = 0xAE;
+    co_return co_await Write_Commands(&command, 1);
+}
+
+SSD1306_Async::Task SSD1306_Async::Display_On(void)
+{
+    const uint8_t command = 0xAF;
+    co_return co_await Write_Commands(&command, 1);
+}
+
+SSD1306_Async::Task SSD1306_Async::Set_Clock(uint8_t divide, uint8_t oscillator)
+{
+    oled.clock = SSD1306::Make_Clock(divide, oscillator);
+    const uint8_t commands[] = { 0xD5, oled.clock };
+    co_return co_await Write_Commands(commands, sizeof(commands));
+}
+
+SSD1306_Async::Task SSD1306_Async::Set_Brightness(uint8_t brightness)
+{
+    const uint8_t commands[] = { 0x81, brightness };
+    co_return co_await Write_Commands(commands, sizeof(commands));
+}
+
+SSD1306_Async::Task SSD1306_Async::Invert_Colors(bool inverted)
+{
+    const uint8_t command = inverted ? 0xA7 : 0xA6;
+    co_return co_await Write_Commands(&command, 1);
+}
+
+SSD1306_Async::Task SSD1306_Async::Flip_Screen(bool flipped)
+{
+    const uint8_t command = flipped ? 0xC0 : 0xC8;
+    oled.flipped = flipped;
+    bool ok = co_await Write_Commands(&command, 1);
+    if (oled.partial)
+    {
+        uint8_t commands[5];
+        oled.Partial_Mode_Commands(commands);
+        ok = co_await Write_Commands(&commands[2], 2) && ok;
+    }
+    co_return ok;
+}
+
+SSD1306_Async::Task SSD1306_Async::Mirror_Screen(bool mirrored)
+{
+    const uint8_t command = mirrored ? 0xA0 : 0xA1;
+    co_return co_await Write_Commands(&command, 1);
+}
+
+#endif /* __cpp_impl_coroutine */
@@ -0,0 +1,186 @@
+/**
+ ******************************************************************************
+ * @file    SSD1306_list.cpp
+ * @author  agent
+ * @date    17.10.2026
+ * @brief   Scrolling list widget for OLED display
+ ******************************************************************************
+ * @attention
+ * <h2><center>&copy; COPYRIGHT(c) 2026 agent </center></h2>
+ *
+ *Permission is hereby granted, free of charge,
+ *to any person obtaining a copy of this software and associated documentation files
+ *(the "Software"), to deal in the Software without restriction,
+ *including without limitation the rights to use, copy, modify,
+ *merge, publish, distribute, sublicense, and/or sell copies of
+ *the Software, and to permit persons to whom the Software is furnished to do so,
+ *subject to the following conditions:
+ *
+ *The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ *THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ *INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ *PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ *FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************************************
+ */
+
+#include <stdint.h>
+#include "SSD1306_list.hpp"
+
+SSD1306_List::SSD1306_List(SSD1306 &display, Item_Text text, void *context, uint16_t count,
+        uint8_t x, uint8_t y, uint8_t width, uint8_t height, Fonts::FontDef font) :
+        oled(display), text(text), context(context), count(count), x(x), y(y), width(width),
+        font(font), row_height(uint8_t(font.FontHeight + 2)), rows(uint8_t(height / row_height))
+{
+}
+
+void SSD1306_List::Draw(void)
+{
+    for (uint8_t row = 0; row < rows; row++)
+    {
+        Draw_Row(row, uint16_t(first + row));
+    }
+    Invert_Selection();
+}
+
+void SSD1306_List::Select(uint16_t index)
+{
+    if (count == 0 || rows == 0)
+    {
+        return;
+    }
+    if (index >= count)
+    {
+        index = uint16_t(count - 1);
+    }
+    if (index == selected)
+    {
+        return;
+    }
+    Invert_Selection(); // highlight must not be moved together with rows
+    selected = index;
+    if (selected < first)
+    {
+        Scroll(selected);
+    }
+    else if (selected >= first + rows)
+    {
+        Scroll(uint16_t(selected - rows + 1));
+    }
+    Invert_Selection();
+}
+
+void SSD1306_List::Next(void)
+{
+    if (selected + 1 < count)
+    {
+        Select(uint16_t(selected + 1));
+    }
+}
+
+void SSD1306_List::Previous(void)
+{
+    if (selected > 0)
+    {
+        Select(uint16_t(selected - 1));
+    }
+}
+
+void SSD1306_List::Set_Count(uint16_t count)
+{
+    this->count = count;
+    if (selected >= count)
+    {
+        selected = (count == 0) ? 0 : uint16_t(count - 1);
+    }
+    if (first > selected)
+    {
+        first = selected;
+    }
+    Draw();
+}
+
+uint16_t SSD1306_List::Get_Selected(void) const
+{
+    return selected;
+}
+
+uint16_t SSD1306_List::Get_First_Visible(void) const
+{
+    return first;
+}
+
+uint8_t SSD1306_List::Get_Visible_Rows(void) const
+{
+    return rows;
+}
+
+void SSD1306_List::Draw_Row(uint8_t row, uint16_t index)
+{
+    const uint8_t row_y = uint8_t(y + row * row_height);
+    oled.Fill_Rectangle(x, row_y, width, row_height, SSD1306::BLACK);
+    if (index >= count)
+    {
+        return;
+    }
+    const Fonts::FontDef previous_font = oled.Get_Font_size();
+    oled.Set_Font_size(font);
+    const char *str = text(context, index);
+    uint8_t column = uint8_t(x + 1);
+    // characters are written one by one, so text is cut at right edge of list
+    for (; *str && column + font.FontWidth <= x + width; str++)
+    {
+        const char character[2] = { *str, 0 };
+        oled.Set_Cursor(column, uint8_t(row_y + 1));
+        oled.Write_String(character);
+        column = uint8_t(column + font.FontWidth);
+    }
+    oled.Set_Font_size(previous_font);
+}
+
+void SSD1306_List::Invert_Selection(void)
+{
+    if (count != 0 && selected >= first && selected < first + rows)
+    {
+        oled.Invert_Region(x, uint8_t(y + (selected - first) * row_height), width, row_height);
+    }
+}
+
+void SSD1306_List::Scroll(uint16_t new_first)
+{
+    if (new_first > first && new_first - first < rows)
+    {
+        // rows move up, new ones appear at the bottom
+        const uint8_t shift = uint8_t(new_first - first);
+        oled.Copy_Region(x, uint8_t(y + shift * row_height), width, uint8_t((rows - shift) * row_height),
+                x, y);
+        first = new_first;
+        for (uint8_t row = uint8_t(rows - shift); row < rows; row++)
+        {
+            Draw_Row(row, uint16_t(first + row));
+        }
+    }
+    else if (new_first < first && first - new_first < rows)
+    {
+        const uint8_t shift = uint8_t(first - new_first);
+        oled.Copy_Region(x, y, width, uint8_t((rows - shift) * row_height), x,
+                int16_t(y + shift * row_height));
+        first = new_first;
+        for (uint8_t row = 0; row < shift; row++)
+        {
+            Draw_Row(row, uint16_t(first + row));
+        }
+    }
+    else
+    {
+        first = new_first;
+        for (uint8_t row = 0; row < rows; row++)
+        {
+            Draw_Row(row, uint16_t(first + row));
+        }
+    }
+}
@@ -0,0 +1,108 @@
+/**
+ ******************************************************************************
+ * @file    SSD1306_mirror.cpp
+ * @author  agent
+ * @date    17.10.2026
+ * @brief   Streaming of display content for remote view
+ ******************************************************************************
+ * @attention
+ * <h2><center>&copy; COPYRIGHT(c) 2026 agent </center></h2>
+ *
+ *Permission is hereby granted, free of charge,
+ *to any person obtaining a copy of this software and associated documentation files
+ *(the "Software"), to deal in the Software without restriction,
+ *including without limitation the rights to use, copy, modify,
+ *merge, publish, distribute, sublicense, and/or sell copies of
+ *the Software, and to permit persons to whom the Software is furnished to do so,
+ *subject to the following conditions:
+ *
+ *The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ *THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ *INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ *PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ *FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************************************
+ */
+
+
+#include <stdint.h>
+#include "SSD1306_mirror.hpp"
+
+namespace
+{
+const uint8_t record_header = 3; // page, column and length of SSD1306_Snapshot delta record
+const uint8_t header_size = 5;
+}
+
+// definitions needed by C++14 when constants are bound to references
+const uint8_t SSD1306_Mirror::sync;
+const uint8_t SSD1306_Mirror::keyframe;
+const uint8_t SSD1306_Mirror::delta;
+const uint16_t SSD1306_Mirror::max_payload;
+
+SSD1306_Mirror::SSD1306_Mirror(SSD1306 &display, Writer write, void *context,
+        uint16_t keyframe_interval) :
+        oled(display), write(write), context(context), keyframe_interval(keyframe_interval)
+{
+    oled.Set_Update_Hook(On_Update, this);
+}
+
+SSD1306_Mirror::~SSD1306_Mirror()
+{
+    oled.Set_Update_Hook(nullptr, nullptr);
+}
+
+void SSD1306_Mirror::Request_Keyframe(void)
+{
+    keyframe_needed = true;
+}
+
+void SSD1306_Mirror::On_Update(void *context, const uint8_t *buffer, uint8_t first_column,
+        uint8_t last_column, uint8_t first_page, uint8_t last_page)
+{
+    SSD1306_Mirror &self = *static_cast<SSD1306_Mirror*>(context);
+    bool ok;
+    if (self.keyframe_needed
+            || (self.keyframe_interval > 0 && self.packets_since_keyframe + 1 >= self.keyframe_interval))
+    {
+        // buffer can already contain changes which are not sent yet, they are shown a bit earlier
+        ok = self.Send(buffer, keyframe, 0, 127, 0, uint8_t(self.oled.Get_Height() / 8 - 1));
+        self.packets_since_keyframe = 0;
+    }
+    else
+    {
+        ok = self.Send(buffer, delta, first_column, last_column, first_page, last_page);
+        self.packets_since_keyframe++;
+    }
+    // receiver could get part of packet, so it has to start again from keyframe
+    self.keyframe_needed = !ok;
+}
+
+bool SSD1306_Mirror::Send(const uint8_t *buffer, uint8_t type, uint8_t first_column, uint8_t last_column,
+        uint8_t first_page, uint8_t last_page)
+{
+    const uint8_t columns = uint8_t(last_column - first_column + 1);
+    const uint16_t length = uint16_t((last_page - first_page + 1) * (record_header + columns));
+    const uint8_t header[header_size] = { sync, type, sequence++, uint8_t(length), uint8_t(length >> 8) };
+    uint8_t sum = 0;
+    bool ok = write(context, header, header_size);
+    for (uint8_t page = first_page; ok && page <= last_page; page++)
+    {
+        const uint8_t record[record_header] = { page, first_column, columns };
+        const uint8_t *bytes = &buffer[page * 128 + first_column];
+        for (uint8_t i = 0; i < record_header; i++)
+        {
+            sum = uint8_t(sum + record[i]);
+        }
+        for (uint8_t i = 0; i < columns; i++)
+        {
+            sum = uint8_t(sum + bytes[i]);
+        }
+        ok = write(context, record, record_header) && write(context, bytes, columns);
+    }
+    return ok && write(context, &sum, 1);
+}
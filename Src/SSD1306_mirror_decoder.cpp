@@ -0,0 +1,120 @@
+/**
+ ******************************************************************************
+ * @file    SSD1306_mirror_decoder.cpp
+ * @author  agent
+ * @date    17.10.2026
+ * @brief   Decoder of stream sent by SSD1306_Mirror (does not need display)
+ ******************************************************************************
+ * @attention
+ * <h2><center>&copy; COPYRIGHT(c) 2026 agent </center></h2>
+ *
+ *Permission is hereby granted, free of charge,
+ *to any person obtaining a copy of this software and associated documentation files
+ *(the "Software"), to deal in the Software without restriction,
+ *including without limitation the rights to use, copy, modify,
+ *merge, publish, distribute, sublicense, and/or sell copies of
+ *the Software, and to permit persons to whom the Software is furnished to do so,
+ *subject to the following conditions:
+ *
+ *The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ *THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ *INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ *PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ *FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************************************
+ */
+
+#include <stdint.h>
+#include "SSD1306_mirror.hpp"
+
+bool SSD1306_Mirror::Decoder::Feed(uint8_t byte)
+{
+    switch (state)
+    {
+    case SYNC:
+        if (byte == sync)
+        {
+            state = TYPE;
+        }
+        break;
+    case TYPE:
+        type = byte;
+        state = (type == keyframe || type == delta) ? SEQUENCE : (byte == sync ? TYPE : SYNC);
+        break;
+    case SEQUENCE:
+        sequence = byte;
+        state = LENGTH_LOW;
+        break;
+    case LENGTH_LOW:
+        length = byte;
+        state = LENGTH_HIGH;
+        break;
+    case LENGTH_HIGH:
+        length = uint16_t(length | byte << 8);
+        received = 0;
+        sum = 0;
+        if (length > max_payload)
+        {
+            errors++;
+            synchronized = false;
+            state = SYNC;
+        }
+        else
+        {
+            state = length > 0 ? PAYLOAD : CHECKSUM;
+        }
+        break;
+    case PAYLOAD:
+        payload[received++] = byte;
+        sum = uint8_t(sum + byte);
+        if (received == length)
+        {
+            state = CHECKSUM;
+        }
+        break;
+    case CHECKSUM:
+        state = SYNC;
+        return Complete(byte);
+    }
+    return false;
+}
+
+uint16_t SSD1306_Mirror::Decoder::Feed(const uint8_t *data, uint32_t size)
+{
+    uint16_t packets = 0;
+    for (uint32_t i = 0; i < size; i++)
+    {
+        packets = uint16_t(packets + Feed(data[i]));
+    }
+    return packets;
+}
+
+bool SSD1306_Mirror::Decoder::Complete(uint8_t checksum)
+{
+    if (checksum != sum)
+    {
+        errors++;
+        synchronized = false;
+        return false;
+    }
+    if (type == delta && (!synchronized || sequence != expected_sequence))
+    {
+        if (synchronized)
+        {
+            errors++; // lost packet
+        }
+        synchronized = false;
+        return false;
+    }
+    expected_sequence = uint8_t(sequence + 1);
+    synchronized = SSD1306_Snapshot::Apply_Delta(image, payload, length);
+    if (!synchronized)
+    {
+        errors++;
+    }
+    return synchronized;
+}
@@ -0,0 +1,118 @@
+/**
+ ******************************************************************************
+ * @file    SSD1306_pacer.cpp
+ * @author  agent
+ * @date    17.10.2026
+ * @brief   Frame pacing for OLED display
+ ******************************************************************************
+ * @attention
+ * <h2><center>&copy; COPYRIGHT(c) 2026 agent </center></h2>
+ *
+ *Permission is hereby granted, free of charge,
+ *to any person obtaining a copy of this software and associated documentation files
+ *(the "Software"), to deal in the Software without restriction,
+ *including without limitation the rights to use, copy, modify,
+ *merge, publish, distribute, sublicense, and/or sell copies of
+ *the Software, and to permit persons to whom the Software is furnished to do so,
+ *subject to the following conditions:
+ *
+ *The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ *THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ *INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ *PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ *FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************************************
+ */
+
+#include <stdint.h>
+#include "SSD1306_pacer.hpp"
+
+SSD1306_Frame_Pacer::SSD1306_Frame_Pacer(SSD1306 &display,
+        uint32_t (*time_source)(void), uint16_t max_fps) :
+        oled(display), now(time_source)
+{
+    Set_Max_Fps(max_fps);
+}
+
+void SSD1306_Frame_Pacer::Set_Max_Fps(uint16_t max_fps)
+{
+    min_interval = max_fps == 0 ? 0 : 1000000UL / max_fps;
+}
+
+void SSD1306_Frame_Pacer::Synchronize(void)
+{
+    scan_start = now();
+}
+
+void SSD1306_Frame_Pacer::Submit(void)
+{
+    if (pending)
+    {
+        dropped++;
+    }
+    pending = true;
+    Anchor(now());
+}
+
+bool SSD1306_Frame_Pacer::Is_Frame_Due(void) const
+{
+    if (!pending)
+    {
+        return false;
+    }
+    uint32_t time = now();
+    if (sent_any && uint32_t(time - last_sent) < min_interval)
+    {
+        return false;
+    }
+    uint32_t period = oled.Get_Frame_Period_Us();
+    if (period == 0)
+    {
+        return true;
+    }
+    return uint32_t(time - scan_start) % period < period / SSD1306_PACER_WINDOW_DIV;
+}
+
+void SSD1306_Frame_Pacer::Mark_Sent(void)
+{
+    pending = false;
+    sent_any = true;
+    last_sent = now();
+    sent++;
+    Anchor(last_sent);
+}
+
+bool SSD1306_Frame_Pacer::Poll(void)
+{
+    if (!Is_Frame_Due())
+    {
+        return false;
+    }
+    Mark_Sent();
+    oled.Update_Screen();
+    return true;
+}
+
+void SSD1306_Frame_Pacer::Anchor(uint32_t time)
+{
+    uint32_t period = oled.Get_Frame_Period_Us();
+    if (period != 0)
+    {
+        // 2^32 is not multiple of period, so phase is lost if elapsed time wraps around
+        scan_start += uint32_t(time - scan_start) / period * period;
+    }
+}
+
+uint32_t SSD1306_Frame_Pacer::Get_Dropped_Frames(void) const
+{
+    return dropped;
+}
+
+uint32_t SSD1306_Frame_Pacer::Get_Sent_Frames(void) const
+{
+    return sent;
+}
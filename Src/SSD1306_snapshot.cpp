@@ -0,0 +1,201 @@
+/**
+ ******************************************************************************
+ * @file    SSD1306_snapshot.cpp
+ * @author  agent
+ * @date    17.10.2026
+ * @brief   Delta and run-length encoding of display snapshots
+ ******************************************************************************
+ * @attention
+ * <h2><center>&copy; COPYRIGHT(c) 2026 agent </center></h2>
+ *
+ *Permission is hereby granted, free of charge,
+ *to any person obtaining a copy of this software and associated documentation files
+ *(the "Software"), to deal in the Software without restriction,
+ *including without limitation the rights to use, copy, modify,
+ *merge, publish, distribute, sublicense, and/or sell copies of
+ *the Software, and to permit persons to whom the Software is furnished to do so,
+ *subject to the following conditions:
+ *
+ *The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ *THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ *INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ *PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ *FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************************************
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "SSD1306_snapshot.hpp"
+
+bool SSD1306_Snapshot::Encode_Delta(const uint8_t *from, const uint8_t *to, uint8_t *delta,
+        uint16_t capacity, uint16_t &delta_size)
+{
+    delta_size = 0;
+    for (uint8_t page = 0; page < size / width; page++)
+    {
+        const uint8_t *before = &from[page * width];
+        const uint8_t *after = &to[page * width];
+        uint8_t column = 0;
+        while (column < width)
+        {
+            if (before[column] == after[column])
+            {
+                column++;
+                continue;
+            }
+            // record is extended over gaps shorter than its header
+            uint8_t end = uint8_t(column + 1);
+            for (uint8_t i = end; i < width && i - end < record_header; i++)
+            {
+                if (before[i] != after[i])
+                {
+                    end = uint8_t(i + 1);
+                }
+            }
+            const uint8_t length = uint8_t(end - column);
+            if (delta_size + record_header + length > capacity)
+            {
+                return false;
+            }
+            delta[delta_size++] = page;
+            delta[delta_size++] = column;
+            delta[delta_size++] = length;
+            memcpy(&delta[delta_size], &after[column], length);
+            delta_size = uint16_t(delta_size + length);
+            column = end;
+        }
+    }
+    return true;
+}
+
+bool SSD1306_Snapshot::Apply_Delta(uint8_t *image, const uint8_t *delta, uint16_t delta_size)
+{
+    uint16_t position = 0;
+    while (position < delta_size)
+    {
+        if (delta_size - position < record_header)
+        {
+            return false;
+        }
+        const uint8_t page = delta[position];
+        const uint8_t column = delta[position + 1];
+        const uint8_t length = delta[position + 2];
+        position = uint16_t(position + record_header);
+        if (page >= size / width || length == 0 || column + length > width
+                || delta_size - position < length)
+        {
+            return false;
+        }
+        memcpy(&image[page * width + column], &delta[position], length);
+        position = uint16_t(position + length);
+    }
+    return true;
+}
+
+bool SSD1306_Snapshot::Encode_Rle(const uint8_t *image, uint8_t *output, uint16_t capacity,
+        uint16_t &output_size)
+{
+    output_size = 0;
+    uint16_t i = 0;
+    uint16_t literal_start = 0; // literal bytes wait until run or limit ends them
+    while (i <= size)
+    {
+        uint16_t run = 1;
+        while (i < size && i + run < size && run < max_run && image[i + run] == image[i])
+        {
+            run++;
+        }
+        const bool is_run = i < size && run >= 3; // shorter runs are cheaper as literals
+        const uint16_t literal = uint16_t(i - literal_start);
+        if (literal > 0 && (is_run || i == size || literal == max_literal))
+        {
+            if (output_size + 1 + literal > capacity)
+            {
+                return false;
+            }
+            output[output_size++] = uint8_t(literal - 1);
+            memcpy(&output[output_size], &image[literal_start], literal);
+            output_size = uint16_t(output_size + literal);
+            literal_start = i;
+        }
+        if (i == size)
+        {
+            break;
+        }
+        if (is_run)
+        {
+            if (output_size + 2 > capacity)
+            {
+                return false;
+            }
+            output[output_size++] = uint8_t(run + 126);
+            output[output_size++] = image[i];
+            i = uint16_t(i + run);
+            literal_start = i;
+        }
+        else
+        {
+            i++;
+        }
+    }
+    return true;
+}
+
+bool SSD1306_Snapshot::Decode_Rle(const uint8_t *input, uint16_t input_size, uint8_t *image)
+{
+    uint16_t position = 0;
+    uint16_t decoded = 0;
+    while (position < input_size)
+    {
+        const uint8_t control = input[position++];
+        if (control < 128)
+        {
+            const uint16_t literal = uint16_t(control + 1);
+            if (input_size - position < literal || size - decoded < literal)
+            {
+                return false;
+            }
+            memcpy(&image[decoded], &input[position], literal);
+            position = uint16_t(position + literal);
+            decoded = uint16_t(decoded + literal);
+        }
+        else
+        {
+            const uint16_t run = uint16_t(control - 126);
+            if (position >= input_size || size - decoded < run)
+            {
+                return false;
+            }
+            memset(&image[decoded], input[position++], run);
+            decoded = uint16_t(decoded + run);
+        }
+    }
+    return decoded == size;
+}
+
+uint16_t SSD1306_Snapshot::Encode_Pbm(const uint8_t *image, uint8_t *output)
+{
+    static const char header[] = "P4\n128 64\n";
+    const uint8_t height = size / width * 8;
+    uint16_t n = sizeof(header) - 1;
+    memcpy(output, header, n);
+    // PBM rows are stored left to right with most significant bit first
+    for (uint8_t y = 0; y < height; y++)
+    {
+        for (uint8_t x = 0; x < width; x += 8)
+        {
+            uint8_t bits = 0;
+            for (uint8_t i = 0; i < 8; i++)
+            {
+                bits = uint8_t(bits << 1 | ((image[(y / 8) * width + x + i] >> (y % 8)) & 1));
+            }
+            output[n++] = bits;
+        }
+    }
+    return n;
+}
@@ -0,0 +1,479 @@
+/**
+ ******************************************************************************
+ * @file    SSD1306_trace.cpp
+ * @author  agent
+ * @date    18.10.2026
+ * @brief   Recording and decoding of command stream sent to display
+ ******************************************************************************
+ * @attention
+ * <h2><center>&copy; COPYRIGHT(c) 2026 agent </center></h2>
+ *
+ *Permission is hereby granted, free of charge,
+ *to any person obtaining a copy of this software and associated documentation files
+ *(the "Software"), to deal in the Software without restriction,
+ *including without limitation the rights to use, copy, modify,
+ *merge, publish, distribute, sublicense, and/or sell copies of
+ *the Software, and to permit persons to whom the Software is furnished to do so,
+ *subject to the following conditions:
+ *
+ *The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ *THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ *INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ *PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ *FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************************************
+ */
+
+
+// Compiled only when trace is enabled, otherwise SSD1306 has no trace hook
+#include "SSD1306.hpp"
+#if SSD1306_TRACE
+
+#include <stdint.h>
+#include "SSD1306_trace.hpp"
+
+namespace
+{
+const uint8_t control_data = 0x40; // control byte of display data, see SSD1306::Set_Trace_Hook
+
+/// Builds zero terminated text in fixed buffer, without printf, longer text is cut
+class Text_Builder
+{
+public:
+    Text_Builder(char *text, uint8_t size) :
+            text(text), size(size)
+    {
+        text[0] = '\0';
+    }
+
+    Text_Builder& Add(const char *string)
+    {
+        while (*string != '\0' && length + 1 < size)
+        {
+            text[length++] = *string++;
+        }
+        text[length] = '\0';
+        return *this;
+    }
+
+    Text_Builder& Number(uint32_t value, uint8_t width = 0)
+    {
+        char digits[11];
+        uint8_t count = 0;
+        do
+        {
+            digits[count++] = char('0' + value % 10);
+            value /= 10;
+        } while (value != 0);
+        for (; width > count; width--)
+        {
+            Add(" ");
+        }
+        while (count > 0 && length + 1 < size)
+        {
+            text[length++] = digits[--count];
+        }
+        text[length] = '\0';
+        return *this;
+    }
+
+    Text_Builder& Hex(uint8_t value)
+    {
+        const char digits[] = "0123456789ABCDEF";
+        const char hex[] = { '0', 'x', digits[value >> 4], digits[value & 0x0F], '\0' };
+        return Add(hex);
+    }
+
+private:
+    char *text;
+    uint8_t size;
+    uint8_t length = 0;
+};
+
+/// Counters printed after frame and at the end
+struct Totals
+{
+    uint32_t frames;
+    uint32_t transfers;
+    uint32_t command_bytes;
+    uint32_t data_bytes;
+    uint32_t errors;
+};
+
+void Print_Totals(Text_Builder &line, const Totals &totals)
+{
+    line.Number(totals.transfers).Add(" transfers, ").Number(totals.command_bytes).Add(" command bytes, ");
+    line.Number(totals.data_bytes).Add(" data bytes, ").Number(totals.errors).Add(" errors");
+}
+}
+
+// definitions needed by C++14 when constants are bound to references
+const uint8_t SSD1306_Trace::type_mask;
+const uint8_t SSD1306_Trace::continued;
+const uint8_t SSD1306_Trace::failed;
+
+SSD1306_Trace::SSD1306_Trace(SSD1306 &display, uint32_t (*clock)(void)) :
+        oled(display), clock(clock)
+{
+    oled.Set_Trace_Hook(On_Transfer, this, On_Begin);
+}
+
+SSD1306_Trace::~SSD1306_Trace()
+{
+    oled.Set_Trace_Hook(nullptr, nullptr);
+}
+
+void SSD1306_Trace::Clear(void)
+{
+    first = 0;
+    count = 0;
+    dropped = 0;
+}
+
+void SSD1306_Trace::Pause(bool paused)
+{
+    this->paused = paused;
+}
+
+uint16_t SSD1306_Trace::Size(void) const
+{
+    return count;
+}
+
+const SSD1306_Trace::Entry& SSD1306_Trace::Get(uint16_t index) const
+{
+    return entries[(first + index) % SSD1306_TRACE_ENTRIES];
+}
+
+SSD1306_Trace::Entry& SSD1306_Trace::Add(void)
+{
+    if (count == SSD1306_TRACE_ENTRIES)
+    {
+        first = uint16_t((first + 1) % SSD1306_TRACE_ENTRIES);
+        dropped++;
+    }
+    else
+    {
+        count++;
+    }
+    return entries[(first + count - 1) % SSD1306_TRACE_ENTRIES];
+}
+
+void SSD1306_Trace::On_Begin(void *context)
+{
+    SSD1306_Trace &self = *static_cast<SSD1306_Trace*>(context);
+    self.begin_time = self.clock != nullptr ? self.clock() : 0;
+}
+
+void SSD1306_Trace::On_Transfer(void *context, uint8_t control_byte, const uint8_t *data, uint16_t size,
+        bool succeeded)
+{
+    SSD1306_Trace &self = *static_cast<SSD1306_Trace*>(context);
+    if (self.paused)
+    {
+        return;
+    }
+    // transfers are stamped with their start, end of window with current time
+    uint32_t time = self.begin_time;
+    if (data == nullptr)
+    {
+        time = self.clock != nullptr ? self.clock() : 0;
+    }
+    const uint8_t result = succeeded ? 0 : failed;
+    if (data == nullptr || control_byte == control_data)
+    {
+        Entry &entry = self.Add();
+        entry.time = time;
+        entry.size = size;
+        entry.type = uint8_t((data == nullptr ? WINDOW : DATA) | result);
+        entry.count = 0;
+        return;
+    }
+    // commands are split between entries, so all of them can be decoded
+    uint16_t position = 0;
+    do
+    {
+        Entry &entry = self.Add();
+        entry.time = time;
+        entry.size = size;
+        entry.type = uint8_t(COMMANDS | result | (position != 0 ? continued : 0));
+        entry.count = 0;
+        while (position < size && entry.count < SSD1306_TRACE_BYTES)
+        {
+            entry.bytes[entry.count++] = data[position++];
+        }
+    } while (position < size);
+}
+
+void SSD1306_Trace::Print(Printer print, void *context) const
+{
+    char buffer[96];
+    Command_Decoder decoder;
+    Totals frame = { };
+    Totals all = { };
+    uint32_t frame_start = 0;
+    bool frame_started = false;
+
+    if (dropped != 0)
+    {
+        Text_Builder line(buffer, sizeof(buffer));
+        line.Add("(").Number(dropped).Add(" older entries dropped)\n");
+        print(context, buffer);
+    }
+    for (uint16_t i = 0; i < count; i++)
+    {
+        const Entry &entry = Get(i);
+        const uint8_t type = entry.type & type_mask;
+        if (entry.type & continued)
+        {
+            if (i == 0)
+            {
+                continue; // beginning of transfer was overwritten
+            }
+        }
+        else if (type != WINDOW)
+        {
+            frame.transfers++;
+            frame.errors += (entry.type & failed) ? 1 : 0;
+            (type == COMMANDS ? frame.command_bytes : frame.data_bytes) += entry.size;
+        }
+        if (!frame_started)
+        {
+            frame_start = entry.time;
+            frame_started = true;
+        }
+
+        Text_Builder line(buffer, sizeof(buffer));
+        if (type == COMMANDS)
+        {
+            for (uint8_t j = 0; j < entry.count; j++)
+            {
+                if (decoder.Feed(entry.bytes[j]))
+                {
+                    line.Number(entry.time, 10).Add(" us  ").Add(decoder.Text());
+                    line.Add((entry.type & failed) ? " (FAILED)\n" : "\n");
+                    print(context, buffer);
+                    line = Text_Builder(buffer, sizeof(buffer));
+                }
+            }
+        }
+        else if (type == DATA)
+        {
+            line.Number(entry.time, 10).Add(" us  DATA ").Number(entry.size).Add(" bytes");
+            line.Add((entry.type & failed) ? " (FAILED)\n" : "\n");
+            print(context, buffer);
+        }
+        else
+        {
+            all.frames++;
+            line.Add("              FRAME ").Number(all.frames).Add((entry.type & failed) ? " FAILED: " : ": ");
+            Print_Totals(line, frame);
+            line.Add(", ").Number(entry.time - frame_start).Add(" us\n");
+            print(context, buffer);
+
+            all.transfers += frame.transfers;
+            all.command_bytes += frame.command_bytes;
+            all.data_bytes += frame.data_bytes;
+            all.errors += frame.errors;
+            frame = Totals { };
+            frame_started = false;
+        }
+    }
+    all.transfers += frame.transfers;
+    all.command_bytes += frame.command_bytes;
+    all.data_bytes += frame.data_bytes;
+    all.errors += frame.errors;
+
+    Text_Builder line(buffer, sizeof(buffer));
+    if (decoder.Is_Pending())
+    {
+        print(context, "              (incomplete command)\n");
+    }
+    line.Add("TOTAL: ").Number(all.frames).Add(" frames, ");
+    Print_Totals(line, all);
+    line.Add("\n");
+    print(context, buffer);
+}
+
+uint8_t SSD1306_Trace::Command_Decoder::Arguments(uint8_t opcode)
+{
+    switch (opcode)
+    {
+    case 0x20: case 0x81: case 0x82: case 0x8D: case 0xA8: case 0xAD:
+    case 0xD3: case 0xD5: case 0xD8: case 0xD9: case 0xDA: case 0xDB:
+        return 1;
+    case 0x21: case 0x22: case 0xA3:
+        return 2;
+    case 0x91:
+        return 4;
+    case 0x29: case 0x2A:
+        return 5;
+    case 0x26: case 0x27:
+        return 6;
+    default:
+        return 0;
+    }
+}
+
+bool SSD1306_Trace::Command_Decoder::Feed(uint8_t byte)
+{
+    command[received++] = byte;
+    if (received <= Arguments(command[0]))
+    {
+        return false;
+    }
+    Format();
+    received = 0;
+    return true;
+}
+
+void SSD1306_Trace::Command_Decoder::Format(void)
+{
+    Text_Builder line(text, sizeof(text));
+    const uint8_t opcode = command[0];
+    const uint8_t *argument = &command[1];
+    if (opcode < 0x10)
+    {
+        line.Add("SET_LOW_COLUMN ").Number(opcode);
+        return;
+    }
+    if (opcode < 0x20)
+    {
+        line.Add("SET_HIGH_COLUMN ").Number((opcode & 0x0F) << 4);
+        return;
+    }
+    if (opcode >= 0x30 && opcode <= 0x33)
+    {
+        line.Add("PUMP_VOLTAGE ").Number(opcode & 0x03);
+        return;
+    }
+    if (opcode >= 0x40 && opcode <= 0x7F)
+    {
+        line.Add("START_LINE ").Number(opcode & 0x3F);
+        return;
+    }
+    if (opcode >= 0xB0 && opcode <= 0xBF)
+    {
+        line.Add("SET_PAGE_START ").Number(opcode & 0x0F);
+        return;
+    }
+    switch (opcode)
+    {
+    case 0x20:
+    {
+        const char *modes[] = { "ADDRESSING HORIZONTAL", "ADDRESSING VERTICAL", "ADDRESSING PAGE" };
+        if (argument[0] < 3)
+        {
+            line.Add(modes[argument[0]]);
+        }
+        else
+        {
+            line.Add("ADDRESSING ").Hex(argument[0]);
+        }
+        break;
+    }
+    case 0x21:
+        line.Add("SET_COLUMN ").Number(argument[0]).Add("..").Number(argument[1]);
+        break;
+    case 0x22:
+        line.Add("SET_PAGE ").Number(argument[0]).Add("..").Number(argument[1]);
+        break;
+    case 0x26:
+    case 0x27:
+        line.Add(opcode == 0x26 ? "SCROLL_RIGHT pages " : "SCROLL_LEFT pages ").Number(argument[1]).Add("..");
+        line.Number(argument[3]).Add(" interval ").Number(argument[2]);
+        break;
+    case 0x29:
+    case 0x2A:
+        line.Add(opcode == 0x29 ? "SCROLL_VERTICAL_RIGHT pages " : "SCROLL_VERTICAL_LEFT pages ");
+        line.Number(argument[1]).Add("..").Number(argument[3]).Add(" interval ").Number(argument[2]);
+        line.Add(" offset ").Number(argument[4]);
+        break;
+    case 0x2E:
+        line.Add("SCROLL_OFF");
+        break;
+    case 0x2F:
+        line.Add("SCROLL_ON");
+        break;
+    case 0x81:
+        line.Add("CONTRAST ").Number(argument[0]);
+        break;
+    case 0x82:
+        line.Add("BRIGHTNESS ").Number(argument[0]);
+        break;
+    case 0x8D:
+        line.Add("CHARGE_PUMP ").Hex(argument[0]);
+        break;
+    case 0x91:
+        line.Add("LOOKUP_TABLE ").Hex(argument[0]).Add(" ").Hex(argument[1]).Add(" ").Hex(argument[2]);
+        line.Add(" ").Hex(argument[3]);
+        break;
+    case 0xA0:
+    case 0xA1:
+        line.Add("SEGMENT_REMAP ").Number(opcode & 0x01);
+        break;
+    case 0xA3:
+        line.Add("VERTICAL_SCROLL_AREA top ").Number(argument[0]).Add(" rows ").Number(argument[1]);
+        break;
+    case 0xA4:
+        line.Add("RAM_CONTENT");
+        break;
+    case 0xA5:
+        line.Add("ALL_PIXELS_ON");
+        break;
+    case 0xA6:
+        line.Add("NORMAL");
+        break;
+    case 0xA7:
+        line.Add("INVERSE");
+        break;
+    case 0xA8:
+        line.Add("MULTIPLEX ").Number(argument[0] + 1).Add(" rows");
+        break;
+    case 0xAD:
+        line.Add("DC_DC ").Hex(argument[0]);
+        break;
+    case 0xAE:
+        line.Add("DISPLAY_OFF");
+        break;
+    case 0xAF:
+        line.Add("DISPLAY_ON");
+        break;
+    case 0xC0:
+        line.Add("COM_SCAN NORMAL");
+        break;
+    case 0xC8:
+        line.Add("COM_SCAN REMAPPED");
+        break;
+    case 0xD3:
+        line.Add("DISPLAY_OFFSET ").Number(argument[0]);
+        break;
+    case 0xD5:
+        line.Add("CLOCK divide ").Number((argument[0] & 0x0F) + 1).Add(" oscillator ").Number(argument[0] >> 4);
+        break;
+    case 0xD8:
+        line.Add("AREA_COLOR ").Hex(argument[0]);
+        break;
+    case 0xD9:
+        line.Add("PRECHARGE ").Hex(argument[0]);
+        break;
+    case 0xDA:
+        line.Add("COM_PINS ").Hex(argument[0]);
+        break;
+    case 0xDB:
+        line.Add("VCOMH ").Hex(argument[0]);
+        break;
+    case 0xE3:
+        line.Add("NOP");
+        break;
+    default:
+        line.Add("UNKNOWN ").Hex(opcode);
+        break;
+    }
+}
+
+#endif /* SSD1306_TRACE */
@@ -0,0 +1,150 @@
+/**
+ ******************************************************************************
+ * @file    SSD1306_transition.cpp
+ * @author  agent
+ * @date    17.10.2026
+ * @brief   Screen transition effects for OLED display
+ ******************************************************************************
+ * @attention
+ * <h2><center>&copy; COPYRIGHT(c) 2026 agent </center></h2>
+ *
+ *Permission is hereby granted, free of charge,
+ *to any person obtaining a copy of this software and associated documentation files
+ *(the "Software"), to deal in the Software without restriction,
+ *including without limitation the rights to use, copy, modify,
+ *merge, publish, distribute, sublicense, and/or sell copies of
+ *the Software, and to permit persons to whom the Software is furnished to do so,
+ *subject to the following conditions:
+ *
+ *The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ *THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ *INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ *PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ *FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************************************
+ */
+
+#include <stdint.h>
+#include "SSD1306_transition.hpp"
+
+SSD1306_Transition::SSD1306_Transition(SSD1306 &display) :
+        oled(display)
+{
+}
+
+bool SSD1306_Transition::Start(const uint8_t *image, Effect effect, uint8_t steps)
+{
+    if (image == nullptr || oled.Is_Partial_Mode())
+    {
+        return false;
+    }
+    const uint8_t pages = uint8_t(oled.Get_Height() / 8);
+    if (effect == SLIDE_UP || effect == SLIDE_DOWN)
+    {
+        if (pages == 8)
+        {
+            steps = pages;
+        }
+        else // start line wraps around 64 rows, so rows of smaller display can not be rotated
+        {
+            effect = (effect == SLIDE_UP) ? WIPE_UP : WIPE_DOWN;
+        }
+    }
+    next = image;
+    this->effect = effect;
+    this->steps = (steps == 0) ? 1 : steps;
+    step = 0;
+    return true;
+}
+
+bool SSD1306_Transition::Step(void)
+{
+    if (next == nullptr)
+    {
+        return false;
+    }
+    const uint8_t width = 128;
+    const uint8_t height = oled.Get_Height();
+    const uint8_t pages = uint8_t(height / 8);
+    switch (effect)
+    {
+    case SLIDE_UP:
+        // page which goes out at the top is replaced with next one, start line makes it appear at the bottom
+        Reveal(0, uint8_t(step * 8), width, 8);
+        oled.Set_Start_Line(uint8_t((step + 1) * 8));
+        break;
+    case SLIDE_DOWN:
+        Reveal(0, uint8_t((pages - 1 - step) * 8), width, 8);
+        oled.Set_Start_Line(uint8_t(64 - (step + 1) * 8));
+        break;
+    case WIPE_LEFT:
+        Reveal(uint8_t(width - Band_Begin(width, uint8_t(step + 1))), 0,
+                uint8_t(Band_Begin(width, uint8_t(step + 1)) - Band_Begin(width, step)), height);
+        break;
+    case WIPE_RIGHT:
+        Reveal(Band_Begin(width, step), 0,
+                uint8_t(Band_Begin(width, uint8_t(step + 1)) - Band_Begin(width, step)), height);
+        break;
+    case WIPE_UP:
+        Reveal(0, uint8_t(height - Band_Begin(height, uint8_t(step + 1))), width,
+                uint8_t(Band_Begin(height, uint8_t(step + 1)) - Band_Begin(height, step)));
+        break;
+    case WIPE_DOWN:
+        Reveal(0, Band_Begin(height, step), width,
+                uint8_t(Band_Begin(height, uint8_t(step + 1)) - Band_Begin(height, step)));
+        break;
+    case DISSOLVE:
+    {
+        // block count is 16 * pages (pages 2..8), multiplier is coprime to it, so every block is visited once
+        const uint8_t blocks = uint8_t(16 * pages);
+        for (uint8_t i = Band_Begin(blocks, step); i < Band_Begin(blocks, uint8_t(step + 1)); i++)
+        {
+            uint8_t block = uint8_t((i * 97 + 29) % blocks);
+            Reveal(uint8_t((block % 16) * 8), uint8_t((block / 16) * 8), 8, 8);
+        }
+        break;
+    }
+    }
+
+    step++;
+    if (step >= steps)
+    {
+        next = nullptr;
+    }
+    return next != nullptr;
+}
+
+void SSD1306_Transition::Finish(void)
+{
+    while (Step())
+    {
+    }
+}
+
+bool SSD1306_Transition::Is_Running(void) const
+{
+    return next != nullptr;
+}
+
+void SSD1306_Transition::Reveal(uint8_t x, uint8_t y, uint8_t width, uint8_t height)
+{
+    if (width == 0 || height == 0)
+    {
+        return;
+    }
+    oled.Draw_Image_Region(next, x, y, width, height);
+    oled.Update_Region(x, y, width, height);
+}
+
+uint8_t SSD1306_Transition::Band_Begin(uint8_t extent, uint8_t index) const
+{
+    if (index >= steps)
+    {
+        return extent;
+    }
+    return uint8_t(uint16_t(extent) * index / steps);
+}
@@ -0,0 +1,215 @@
+/**
+ ******************************************************************************
+ * @file    SSD1306_animation_test.cpp
+ * @author  agent
+ * @date    17.10.2026
+ * @brief   Unit test for keyframe animation scheduler
+ ******************************************************************************
+ * <h2><center>&copy; COPYRIGHT(c) 2026 agent
+ * </center></h2>
+ *
+ *Permission is hereby granted, free of charge,
+ *to any person obtaining a copy of this software and associated documentation files
+ *(the "Software"), to deal in the Software without restriction,
+ *including without limitation the rights to use, copy, modify,
+ *merge, publish, distribute, sublicense, and/or sell copies of
+ *the Software, and to permit persons to whom the Software is furnished to do so,
+ *subject to the following conditions:
+ *
+ *The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ *THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ *INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ *PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ *FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************************************
+ */
+
+#include <vector>
+#include "catch.hpp"
+#include "SSD1306.hpp"
+#include "SSD1306_animation.hpp"
+#include "testing.hpp"
+#include "emulator.hpp"
+
+namespace
+{
+  void *dummy_animation;
+  SSD1306 oled_animation(&dummy_animation, 64);
+
+  uint32_t fake_time;
+  uint32_t Fake_Clock(void)
+  {
+    return fake_time;
+  }
+
+  struct Drawn
+  {
+    int16_t x, y;
+    uint8_t frame;
+  };
+  std::vector<Drawn> drawn;
+
+  /// Square of 8x8 pixels, frame 1 is hollow
+  void Draw_Square(void *context, SSD1306 &display, int16_t x, int16_t y, uint8_t frame)
+  {
+    REQUIRE(context == &drawn);
+    drawn.push_back(Drawn { x, y, frame });
+    for (int16_t row = 0; row < 8; row++)
+      {
+        for (int16_t column = 0; column < 8; column++)
+          {
+            bool edge = row == 0 || row == 7 || column == 0 || column == 7;
+            if ((frame == 0 || edge) && x + column >= 0 && y + row >= 0)
+              {
+                display.Draw_Pixel(uint8_t(x + column), uint8_t(y + row), SSD1306::Color::WHITE);
+              }
+          }
+      }
+  }
+
+  const SSD1306_Animator::Keyframe move_right[] = { { 0, 0, 0, 0 }, { 1000, 100, 0, 0 } };
+  const SSD1306_Animator::Keyframe blink[] = { { 0, 60, 40, 0 }, { 500, 60, 40, 1 }, { 1000, 60, 40, 0 } };
+
+  uint32_t Lit_Pixels(void)
+  {
+    uint32_t lit = 0;
+    for (uint8_t y = 0; y < 64; y++)
+      {
+        for (uint8_t x = 0; x < 128; x++)
+          {
+            lit += testing::ssd1306::panel.Pixel(x, y);
+          }
+      }
+    return lit;
+  }
+}
+
+TEST_CASE( "animation interpolates position and sends union of changed regions")
+{
+  testing::ssd1306::panel.Reset();
+  oled_animation.Initialize();
+  fake_time = 0xFFFFFF00; //time wraps around during animation
+  SSD1306_Animator animator(oled_animation, Fake_Clock);
+  int8_t slot = animator.Start(SSD1306_Animator::Animation { Draw_Square, &drawn, 8, 8, move_right, 2, false });
+  REQUIRE(slot == 0);
+
+  drawn.clear();
+  REQUIRE(animator.Tick());
+  REQUIRE(animator.Get_Last_Region().x == 0);
+  REQUIRE(animator.Get_Last_Region().width == 8);
+  REQUIRE(Lit_Pixels() == 64);
+
+  testing::ssd1306::data.clear();
+  REQUIRE_FALSE(animator.Tick()); //nothing changed
+  REQUIRE(testing::ssd1306::data.empty());
+
+  fake_time += 505; //x = 50
+  REQUIRE(animator.Tick());
+  REQUIRE(drawn.back().x == 50);
+  REQUIRE(animator.Get_Last_Region().x == 0);
+  REQUIRE(animator.Get_Last_Region().width == 58);
+  REQUIRE(animator.Get_Last_Region().height == 8);
+  REQUIRE(testing::ssd1306::panel.Pixel(50, 0));
+  REQUIRE_FALSE(testing::ssd1306::panel.Pixel(0, 0));
+  REQUIRE(Lit_Pixels() == 64);
+
+  fake_time += 5000; //finished, stays at last keyframe
+  REQUIRE(animator.Tick());
+  REQUIRE(drawn.back().x == 100);
+  REQUIRE_FALSE(animator.Is_Running(slot));
+  REQUIRE(testing::ssd1306::panel.Pixel(107, 7));
+  REQUIRE(Lit_Pixels() == 64);
+  REQUIRE_FALSE(animator.Tick());
+}
+
+TEST_CASE( "looping frames and overlapping objects are redrawn")
+{
+  testing::ssd1306::panel.Reset();
+  oled_animation.Initialize();
+  fake_time = 0;
+  SSD1306_Animator animator(oled_animation, Fake_Clock);
+  const SSD1306_Animator::Keyframe cross[] = { { 0, 40, 40, 0 }, { 1000, 80, 40, 0 } };
+  int8_t blinking = animator.Start(SSD1306_Animator::Animation { Draw_Square, &drawn, 8, 8, blink, 3, true });
+  int8_t moving = animator.Start(SSD1306_Animator::Animation { Draw_Square, &drawn, 8, 8, cross, 2, true });
+  REQUIRE(blinking == 0);
+  REQUIRE(moving == 1);
+  animator.Tick();
+
+  drawn.clear();
+  fake_time = 1500; //blink in frame 1, moving square at 60 - the same place, drawn after blinking one
+  REQUIRE(animator.Tick());
+  REQUIRE(drawn.size() == 2);
+  REQUIRE(drawn[0].frame == 1);
+  REQUIRE(drawn[1].x == 60);
+  REQUIRE(Lit_Pixels() == 64);
+
+  drawn.clear();
+  fake_time = 1750; //only moving square changes, but blinking one is under cleared area
+  REQUIRE(animator.Tick());
+  REQUIRE(drawn.size() == 2);
+  REQUIRE(drawn[1].x == 70);
+  REQUIRE(animator.Get_Last_Region().x == 60);
+  REQUIRE(animator.Get_Last_Region().width == 18);
+  REQUIRE(Lit_Pixels() == 64 + 28); //filled and hollow square
+
+  animator.Stop(moving);
+  REQUIRE_FALSE(animator.Is_Running(moving));
+  drawn.clear();
+  REQUIRE(animator.Tick());
+  REQUIRE(drawn.empty()); //blinking square does not overlap moving one at 70
+  REQUIRE(Lit_Pixels() == 28);
+  REQUIRE(animator.Is_Running(blinking));
+}
+
+TEST_CASE( "ended animation stays drawn when other object passes over it")
+{
+  testing::ssd1306::panel.Reset();
+  oled_animation.Initialize();
+  fake_time = 0;
+  SSD1306_Animator animator(oled_animation, Fake_Clock);
+  const SSD1306_Animator::Keyframe drop[] = { { 0, 60, 20, 0 }, { 500, 60, 40, 0 } };
+  const SSD1306_Animator::Keyframe cross[] = { { 0, 40, 40, 0 }, { 1000, 80, 40, 0 } };
+  int8_t ending = animator.Start(SSD1306_Animator::Animation { Draw_Square, &drawn, 8, 8, drop, 2, false });
+  int8_t moving = animator.Start(SSD1306_Animator::Animation { Draw_Square, &drawn, 8, 8, cross, 2, true });
+  animator.Tick();
+
+  fake_time = 1000; //first one ended at 60,40
+  animator.Tick();
+  REQUIRE_FALSE(animator.Is_Running(ending));
+  fake_time = 1500; //moving square covers ended one
+  animator.Tick();
+  fake_time = 1750; //and leaves it, cleared area is drawn again
+  drawn.clear();
+  REQUIRE(animator.Tick());
+  REQUIRE(drawn.size() == 2);
+  REQUIRE(drawn[0].x == 60);
+  REQUIRE(drawn[0].y == 40);
+  REQUIRE(testing::ssd1306::panel.Pixel(63, 43));
+  REQUIRE(Lit_Pixels() == 2 * 64);
+
+  animator.Stop(ending); //slot is kept until ended animation is stopped
+  REQUIRE(animator.Tick());
+  REQUIRE_FALSE(testing::ssd1306::panel.Pixel(63, 43));
+  REQUIRE(Lit_Pixels() == 64);
+  REQUIRE(animator.Start(SSD1306_Animator::Animation { Draw_Square, &drawn, 8, 8, drop, 2, false }) == ending);
+  REQUIRE(animator.Is_Running(moving));
+}
+
+TEST_CASE( "animator has fixed number of slots")
+{
+  fake_time = 0;
+  SSD1306_Animator animator(oled_animation, Fake_Clock);
+  for (int8_t i = 0; i < SSD1306_ANIMATION_SLOTS; i++)
+    {
+      REQUIRE(animator.Start(SSD1306_Animator::Animation { Draw_Square, &drawn, 8, 8, blink, 3, true }) == i);
+    }
+  REQUIRE(animator.Start(SSD1306_Animator::Animation { Draw_Square, &drawn, 8, 8, blink, 3, true }) == -1);
+  REQUIRE(animator.Start(SSD1306_Animator::Animation { Draw_Square, &drawn, 8, 8, blink, 0, true }) == -1);
+  animator.Stop(3);
+  animator.Tick(); //stopped slot is freed after its object is cleared
+  REQUIRE(animator.Start(SSD1306_Animator::Animation { Draw_Square, &drawn, 8, 8, move_right, 2, false }) == 3);
+}
@@ -0,0 +1,455 @@
+/**
+ ******************************************************************************
+ * @file    SSD1306_async_test.cpp
+ * @author  agent
+ * @date    17.10.2026
+ * @brief   Unit test for awaitable interface of oled display driver
+ ******************************************************************************
+ * <h2><center>&copy; COPYRIGHT(c) 2026 agent
+ * </center></h2>
+ *
+ *Permission is hereby granted, free of charge,
+ *to any person obtaining a copy of this software and associated documentation files
+ *(the "Software"), to deal in the Software without restriction,
+ *including without limitation the rights to use, copy, modify,
+ *merge, publish, distribute, sublicense, and/or sell copies of
+ *the Software, and to permit persons to whom the Software is furnished to do so,
+ *subject to the following conditions:
+ *
+ *The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ *THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ *INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ *PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ *FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************************************
+ */
+
+#if defined(__cpp_impl_coroutine)
+
+#include <string>
+#include <vector>
+#include "catch.hpp"
+#include "SSD1306.hpp"
+#include "SSD1306_async.hpp"
+#include "SSD1306_trace.hpp"
+#include "testing.hpp"
+
+namespace
+{
+  void *dummy_async;
+  SSD1306 oled_async(&dummy_async, 64);
+  SSD1306_Async::Executor executor;
+  SSD1306_Async async_oled(oled_async, executor);
+
+  uint32_t trace_time;
+  uint32_t Trace_Clock(void)
+  {
+    return trace_time;
+  }
+
+  // Completes transfers one by one, like interrupt would do
+  void Complete_Transfers(int error = 0)
+  {
+    executor.Run();
+    while (testing::ssd1306::transfers_pending > 0)
+    {
+      testing::ssd1306::transfers_pending--;
+      oled_async.Transfer_Complete(error);
+      executor.Run();
+    }
+  }
+}
+
+TEST_CASE( "async update screen waits for end of transfer")
+{
+  testing::ssd1306::data.clear();
+  testing::ssd1306::transfers_pending = 0;
+
+  oled_async.Fill(SSD1306::Color::WHITE);
+  auto task = async_oled.Update_Screen();
+  REQUIRE(task.Is_Valid());
+  REQUIRE(testing::ssd1306::data.size()==0);//lazily started
+
+  executor.Start(task);
+  executor.Run();
+  REQUIRE(testing::ssd1306::data.size()==6);//only commands are sent
+  REQUIRE(async_oled.Is_Busy());
+  REQUIRE_FALSE(task.Is_Done());
+
+  executor.Run();//nothing happens until transfer is completed
+  REQUIRE(testing::ssd1306::data.size()==6);
+
+  Complete_Transfers();
+  REQUIRE(task.Is_Done());
+  REQUIRE(task.Result());
+  REQUIRE_FALSE(async_oled.Is_Busy());
+
+  REQUIRE(testing::ssd1306::data.size()==1030);//1024 data+ 6 bytes of commands
+  REQUIRE(testing::ssd1306::data[0]==0x21);
+  REQUIRE(testing::ssd1306::data[2]==127);
+  REQUIRE(testing::ssd1306::data[5]==7);
+  REQUIRE(testing::ssd1306::data[6]==0xff);
+  REQUIRE(testing::ssd1306::data[1029]==0xff);
+}
+
+TEST_CASE( "executor keeps started tasks apart from coroutines posted by interrupt")
+{
+  testing::ssd1306::transfers_pending = 0;
+  for (uint8_t i = 0; i < SSD1306_ASYNC_QUEUE_SIZE; i++)
+    {
+      REQUIRE(executor.Post(std::noop_coroutine()));
+    }
+  REQUIRE_FALSE(executor.Post(std::noop_coroutine()));
+
+  auto task = async_oled.Update_Screen();
+  REQUIRE(executor.Start(task));//full interrupt queue does not block start
+  REQUIRE_FALSE(executor.Is_Idle());
+  REQUIRE(executor.Run()==SSD1306_ASYNC_QUEUE_SIZE + 1);
+  REQUIRE(executor.Is_Idle());
+  Complete_Transfers();
+  REQUIRE(task.Result());
+}
+
+TEST_CASE( "async window transfer is retried according to retry policy")
+{
+  SSD1306::Retry_Policy policy;
+  policy.attempts = 2;
+  oled_async.Set_Retry_Policy(policy);
+  oled_async.Clean_Errors();
+  testing::ssd1306::data.clear();
+  testing::ssd1306::transfers_pending = 0;
+
+  auto task = async_oled.Update_Screen();
+  executor.Start(task);
+  executor.Run();
+  REQUIRE(testing::ssd1306::transfers_pending==1);//commands
+  testing::ssd1306::transfers_pending = 0;
+  oled_async.Transfer_Complete(0);
+  executor.Run();
+  REQUIRE(testing::ssd1306::transfers_pending==1);//data
+  testing::ssd1306::transfers_pending = 0;
+  oled_async.Transfer_Complete(-5);
+  executor.Run();
+  REQUIRE_FALSE(task.Is_Done());//window is sent again
+  Complete_Transfers();
+  REQUIRE(task.Result());
+  REQUIRE(oled_async.Get_Last_Error()==0);
+  REQUIRE(testing::ssd1306::data.size()==2*1030);
+
+  testing::ssd1306::data.clear();
+  oled_async.Set_Retry_Policy(SSD1306::Retry_Policy());
+}
+
+TEST_CASE( "async initialize sends the same stream as blocking version")
+{
+  void *dummy_sync;
+  SSD1306 oled_sync(&dummy_sync, 64);
+
+  testing::ssd1306::data.clear();
+  oled_sync.Initialize();
+  std::vector<uint8_t> expected = testing::ssd1306::data;
+
+  testing::ssd1306::data.clear();
+  testing::ssd1306::transfers_pending = 0;
+  auto task = async_oled.Initialize();
+  executor.Start(task);
+  Complete_Transfers();
+
+  REQUIRE(task.Result());
+  REQUIRE(oled_async.IsInitialized());
+  REQUIRE(testing::ssd1306::data == expected);
+}
+
+TEST_CASE( "async region update sends narrow region in one transfer")
+{
+  testing::ssd1306::data.clear();
+  testing::ssd1306::transfers_pending = 0;
+
+  oled_async.Clean();
+  oled_async.Draw_Pixel(10, 9, SSD1306::Color::WHITE);
+  auto task = async_oled.Update_Region(10, 6, 3, 4);
+  executor.Start(task);
+  executor.Run();
+  REQUIRE(testing::ssd1306::transfers_pending==1);
+  Complete_Transfers();
+
+  REQUIRE(task.Result());
+  REQUIRE(testing::ssd1306::data.size()==14);//2 pages * 3 columns + 8 bytes of commands
+  REQUIRE(testing::ssd1306::data[0]==0x20);//vertical addressing
+  REQUIRE(testing::ssd1306::data[1]==0x01);
+  REQUIRE(testing::ssd1306::data[2]==0x21);
+  REQUIRE(testing::ssd1306::data[3]==10);
+  REQUIRE(testing::ssd1306::data[4]==12);
+  REQUIRE(testing::ssd1306::data[5]==0x22);
+  REQUIRE(testing::ssd1306::data[6]==0);
+  REQUIRE(testing::ssd1306::data[7]==1);
+  REQUIRE(testing::ssd1306::data[8]==0);//column 10, page 0
+  REQUIRE(testing::ssd1306::data[9]==0x02);//column 10, page 1
+  REQUIRE(testing::ssd1306::data[10]==0);
+}
+
+TEST_CASE( "async update uses page addressing on SH1106")
+{
+  void *dummy_sh1106;
+  SSD1306 sh1106(&dummy_sh1106, 64, SSD1306::ALT_NOREMAP, 0x78, SSD1306::CTRL_SH1106);
+  SSD1306_Async async_sh1106(sh1106, executor);
+  sh1106.Clean();
+  sh1106.Draw_Pixel(20, 9, SSD1306::Color::WHITE);
+
+  testing::ssd1306::data.clear();
+  sh1106.Update_Region(20, 6, 3, 4);
+  std::vector<uint8_t> expected = testing::ssd1306::data;
+
+  testing::ssd1306::data.clear();
+  testing::ssd1306::transfers_pending = 0;
+  auto task = async_sh1106.Update_Region(20, 6, 3, 4);
+  executor.Start(task);
+  executor.Run();
+  while (testing::ssd1306::transfers_pending > 0)
+  {
+    testing::ssd1306::transfers_pending--;
+    sh1106.Transfer_Complete();
+    executor.Run();
+  }
+
+  REQUIRE(task.Result());
+  REQUIRE(testing::ssd1306::data == expected);
+}
+
+TEST_CASE( "async tasks can be chained")
+{
+  testing::ssd1306::data.clear();
+  testing::ssd1306::transfers_pending = 0;
+
+  auto sequence = []() -> SSD1306_Async::Task
+  {
+    bool ok = co_await async_oled.Display_Off();
+    ok = co_await async_oled.Set_Brightness(0x10) && ok;
+    ok = co_await async_oled.Invert_Colors(true) && ok;
+    ok = co_await async_oled.Display_On() && ok;
+    co_return ok;
+  };
+  auto task = sequence();
+  executor.Start(task);
+  Complete_Transfers();
+
+  REQUIRE(task.Result());
+  REQUIRE(testing::ssd1306::data == std::vector<uint8_t>({0xAE, 0x81, 0x10, 0xA7, 0xAF}));
+}
+
+TEST_CASE( "async transfer error is reported")
+{
+  testing::ssd1306::data.clear();
+  testing::ssd1306::transfers_pending = 0;
+  oled_async.Clean_Errors();
+
+  auto task = async_oled.Update_Screen();
+  executor.Start(task);
+  Complete_Transfers(4);
+
+  REQUIRE(task.Is_Done());
+  REQUIRE_FALSE(task.Result());
+  REQUIRE(testing::ssd1306::data.size()<=8);//data is not sent after failed command
+  REQUIRE(oled_async.Get_Last_Error()==4);
+  oled_async.Clean_Errors();
+}
+
+TEST_CASE( "async partial display mode sends deferred pages on exit")
+{
+  testing::ssd1306::transfers_pending = 0;
+  auto init = async_oled.Initialize();
+  executor.Start(init);
+  Complete_Transfers();
+
+  auto sequence = []() -> SSD1306_Async::Task
+  {
+    bool ok = co_await async_oled.Enter_Partial_Mode(0, 16);
+    oled_async.Draw_Pixel(0, 0, SSD1306::Color::WHITE);
+    oled_async.Draw_Pixel(0, 63, SSD1306::Color::WHITE);
+    ok = co_await async_oled.Update_Screen() && ok;
+    ok = co_await async_oled.Exit_Partial_Mode() && ok;
+    co_return ok;
+  };
+  testing::ssd1306::data.clear();
+  auto task = sequence();
+  executor.Start(task);
+  Complete_Transfers();
+
+  REQUIRE(task.Result());
+  REQUIRE_FALSE(oled_async.Is_Partial_Mode());
+  REQUIRE(testing::ssd1306::data.size()==5+(6+256)+5+(6+6*128));
+  REQUIRE(testing::ssd1306::data[1]==15);
+  REQUIRE(testing::ssd1306::data[5+6]==0x01);//page 0
+  REQUIRE(testing::ssd1306::data[5+262+1]==63);
+  REQUIRE(testing::ssd1306::data[5+262+5+4]==2);//deferred pages 2-7 are sent after exit
+  REQUIRE(testing::ssd1306::data[5+262+5+5]==7);
+  REQUIRE(testing::ssd1306::data.back()==0);
+  REQUIRE(testing::ssd1306::data[testing::ssd1306::data.size()-128]==0x80);
+}
+
+TEST_CASE( "async resume initializes display again after transfer error")
+{
+  testing::ssd1306::transfers_pending = 0;
+  oled_async.Clean_Errors();
+  auto init = async_oled.Initialize();
+  executor.Start(init);
+  Complete_Transfers();
+
+  auto sleep = async_oled.Sleep();
+  executor.Start(sleep);
+  Complete_Transfers();
+  testing::ssd1306::data.clear();
+  auto resume = async_oled.Resume();
+  executor.Start(resume);
+  Complete_Transfers();
+  REQUIRE(resume.Result());
+  REQUIRE(testing::ssd1306::data == std::vector<uint8_t>({0xAF}));
+
+  auto failed_sleep = async_oled.Sleep();
+  executor.Start(failed_sleep);
+  Complete_Transfers(2);
+  REQUIRE(oled_async.Get_Last_Error()==2);
+  testing::ssd1306::data.clear();
+  auto reinit = async_oled.Resume();
+  executor.Start(reinit);
+  Complete_Transfers();
+  REQUIRE(reinit.Result());
+  REQUIRE(oled_async.Get_Last_Error()==0);
+  REQUIRE(testing::ssd1306::data.size()==30+1+1030);
+}
+
+TEST_CASE( "failed async transfer is marked for dirty update")
+{
+  testing::ssd1306::transfers_pending = 0;
+  oled_async.Clean_Errors();
+  auto init = async_oled.Initialize();
+  executor.Start(init);
+  Complete_Transfers();
+
+  oled_async.Draw_Line_H(0, 20, 10, SSD1306::Color::WHITE);
+  testing::ssd1306::Inject_Nack(6+5);//in the middle of data
+  auto task = async_oled.Update_Region(0, 16, 10, 8);
+  executor.Start(task);
+  Complete_Transfers();
+  REQUIRE_FALSE(task.Result());
+  oled_async.Clean_Errors();
+
+  testing::ssd1306::data.clear();
+  oled_async.Update_Dirty();
+  REQUIRE(testing::ssd1306::data == std::vector<uint8_t>({0x21, 0, 9, 0x22, 2, 2,
+      0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10}));
+}
+
+TEST_CASE( "coroutine frames are taken from static arena")
+{
+  testing::ssd1306::transfers_pending = 0;
+  REQUIRE(SSD1306_Async::Frame_Arena::Frames_In_Use()==0);
+  {
+    auto task = async_oled.Initialize();
+    executor.Start(task);
+    executor.Run();
+    REQUIRE(SSD1306_Async::Frame_Arena::Frames_In_Use()==2);//Initialize waits for nested Configure
+    Complete_Transfers();
+    REQUIRE(task.Result());
+  }
+  REQUIRE(SSD1306_Async::Frame_Arena::Frames_In_Use()==0);
+
+  // when arena is exhausted task is invalid and fails without transfer
+  std::vector<SSD1306_Async::Task> tasks;
+  for (int i = 0; i < SSD1306_ASYNC_FRAMES; i++)
+  {
+    tasks.push_back(async_oled.Display_On());
+  }
+  auto failed = async_oled.Display_On();
+  REQUIRE_FALSE(failed.Is_Valid());
+  REQUIRE_FALSE(failed.Result());
+  tasks.clear();
+  REQUIRE(SSD1306_Async::Frame_Arena::Frames_In_Use()==0);
+}
+
+TEST_CASE( "async update informs update hook only about sent windows")
+{
+  static std::vector<uint8_t> windows;
+  windows.clear();
+  oled_async.Set_Update_Hook([](void*, const uint8_t*, uint8_t first_column, uint8_t last_column,
+      uint8_t first_page, uint8_t last_page)
+    {
+      windows.insert(windows.end(), { first_column, last_column, first_page, last_page });
+    }, nullptr);
+  testing::ssd1306::transfers_pending = 0;
+
+  auto task = async_oled.Update_Region(10, 8, 20, 16);
+  executor.Start(task);
+  Complete_Transfers();
+  REQUIRE(windows == std::vector<uint8_t>({10, 29, 1, 2}));
+
+  task = async_oled.Update_Region(0, 0, 5, 5);
+  executor.Start(task);
+  Complete_Transfers(SSD1306::ERROR_NACK);
+  REQUIRE(windows.size() == 4);
+  oled_async.Set_Update_Hook(nullptr, nullptr);
+  oled_async.Clean_Errors();
+}
+
+TEST_CASE( "async transfers are traced when they are completed")
+{
+  testing::ssd1306::transfers_pending = 0;
+  SSD1306_Trace trace(oled_async);
+
+  oled_async.Fill(SSD1306::Color::WHITE);
+  auto task = async_oled.Update_Screen();
+  executor.Start(task);
+  executor.Run();
+  REQUIRE(trace.Size() == 0); // commands are not completed yet
+  Complete_Transfers();
+  REQUIRE(trace.Size() == 3);
+
+  task = async_oled.Update_Screen();
+  executor.Start(task);
+  Complete_Transfers(SSD1306::ERROR_NACK);
+  std::string text;
+  trace.Print([](void *context, const char *line)
+    {
+      *static_cast<std::string*>(context) += line;
+    }, &text);
+  CHECK(text.find("DATA 1024 bytes\n") != std::string::npos);
+  CHECK(text.find("FRAME 1: 2 transfers, ") != std::string::npos);
+  CHECK(text.find(" command bytes, 1024 data bytes, 0 errors") != std::string::npos);
+  CHECK(text.find("SET_PAGE 0..7 (FAILED)\n") != std::string::npos);
+  CHECK(text.find("FRAME 2 FAILED: 1 transfers, 6 command bytes, 0 data bytes, 1 errors") != std::string::npos);
+  oled_async.Clean_Errors();
+}
+
+TEST_CASE( "traced frame time includes its first transfer")
+{
+  testing::ssd1306::transfers_pending = 0;
+  SSD1306_Trace trace(oled_async, Trace_Clock);
+
+  auto task = async_oled.Update_Screen();
+  trace_time = 1000;
+  executor.Start(task);
+  executor.Run();
+  trace_time = 1100;//commands sent
+  testing::ssd1306::transfers_pending = 0;
+  oled_async.Transfer_Complete(0);
+  executor.Run();
+  trace_time = 5000;//data sent
+  Complete_Transfers();
+  REQUIRE(task.Result());
+  REQUIRE(trace.Size() == 3);
+  REQUIRE(trace.Get(0).time == 1000);//transfers are stamped with their start
+  REQUIRE(trace.Get(1).time == 1100);
+  REQUIRE(trace.Get(2).time == 5000);
+  std::string text;
+  trace.Print([](void *context, const char *line)
+    {
+      *static_cast<std::string*>(context) += line;
+    }, &text);
+  CHECK(text.find(" 0 errors, 4000 us\n") != std::string::npos);
+}
+
+#endif
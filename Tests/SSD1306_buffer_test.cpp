@@ -0,0 +1,247 @@
+/**
+ ******************************************************************************
+ * @file    SSD1306_buffer_test.cpp
+ * @author  agent
+ * @date    17.10.2026
+ * @brief   Unit test and benchmarks for word-wide buffer operations
+ ******************************************************************************
+ * <h2><center>&copy; COPYRIGHT(c) 2026 agent
+ * </center></h2>
+ *
+ *Permission is hereby granted, free of charge,
+ *to any person obtaining a copy of this software and associated documentation files
+ *(the "Software"), to deal in the Software without restriction,
+ *including without limitation the rights to use, copy, modify,
+ *merge, publish, distribute, sublicense, and/or sell copies of
+ *the Software, and to permit persons to whom the Software is furnished to do so,
+ *subject to the following conditions:
+ *
+ *The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ *THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ *INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ *PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ *FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************************************
+ */
+
+#include <algorithm>
+#include <vector>
+#include "catch.hpp"
+#include "SSD1306.hpp"
+#include "testing.hpp"
+#include "emulator.hpp"
+
+namespace
+{
+  void *dummy_buffer;
+  SSD1306 oled_buffer(&dummy_buffer, 64);
+
+  /// Buffer sent by Update_Screen (without addressing commands)
+  std::vector<uint8_t> Sent_Buffer(void)
+  {
+    testing::ssd1306::data.clear();
+    oled_buffer.Update_Screen();
+    return std::vector<uint8_t>(testing::ssd1306::data.begin() + 6, testing::ssd1306::data.end());
+  }
+}
+
+TEST_CASE( "fills buffer with 4 column pattern")
+{
+  oled_buffer.Fill_Pattern(0x04030201);
+  std::vector<uint8_t> sent = Sent_Buffer();
+  REQUIRE(sent.size() == 1024);
+  for (uint32_t i = 0; i < sent.size(); i++)
+    {
+      REQUIRE(sent[i] == i % 4 + 1);
+    }
+
+  oled_buffer.Fill(SSD1306::Color::WHITE);
+  REQUIRE(Sent_Buffer() == std::vector<uint8_t>(1024, 0xFF));
+  oled_buffer.Clean();
+  REQUIRE(Sent_Buffer() == std::vector<uint8_t>(1024, 0));
+}
+
+TEST_CASE( "inverts only pixels of region")
+{
+  testing::ssd1306::panel.Reset();
+  oled_buffer.Initialize();
+  oled_buffer.Fill_Pattern(0xAA55AA55);
+  oled_buffer.Update_Screen();
+  testing::ssd1306::data.clear();
+
+  oled_buffer.Invert_Region(3, 5, 70, 20); //rows 5-24 span pages 0-3, unaligned columns
+  oled_buffer.Update_Dirty();
+  REQUIRE(testing::ssd1306::data[0] == 0x21);
+  REQUIRE(testing::ssd1306::data[1] == 3);
+  REQUIRE(testing::ssd1306::data[2] == 72);
+  REQUIRE(testing::ssd1306::data[4] == 0);
+  REQUIRE(testing::ssd1306::data[5] == 3);
+
+  for (uint8_t y = 0; y < 64; y++)
+    {
+      for (uint8_t x = 0; x < 128; x++)
+        {
+          bool checker = ((x + y) % 2) == 0;
+          bool inside = x >= 3 && x < 73 && y >= 5 && y < 25;
+          REQUIRE(testing::ssd1306::panel.Pixel(x, y) == (checker != inside));
+        }
+    }
+
+  oled_buffer.Invert_Region(120, 60, 100, 100); //clipped to display
+  oled_buffer.Invert_Region(3, 5, 70, 20);
+  oled_buffer.Invert_Region(120, 60, 8, 4);
+  oled_buffer.Update_Dirty();
+  std::vector<uint8_t> pattern(1024);
+  for (uint32_t i = 0; i < pattern.size(); i++)
+    {
+      pattern[i] = (i % 2) ? 0xAA : 0x55;
+    }
+  REQUIRE(oled_buffer.Is_Equal(pattern.data()));
+  REQUIRE(testing::ssd1306::panel.Pixel(127, 63) == true);
+  REQUIRE(testing::ssd1306::panel.Pixel(126, 63) == false);
+}
+
+TEST_CASE( "compares buffer with image")
+{
+  std::vector<uint8_t> image(1024 + 1);
+  for (uint32_t i = 0; i < image.size(); i++)
+    {
+      image[i] = uint8_t(i * 6);
+    }
+  oled_buffer.Draw_Image(image.data());
+  REQUIRE(oled_buffer.Is_Equal(image.data()));
+  REQUIRE_FALSE(oled_buffer.Is_Equal(image.data() + 1)); //unaligned image
+
+  oled_buffer.Draw_Pixel(127, 56, SSD1306::Color::WHITE); //first bit of last byte
+  REQUIRE_FALSE(oled_buffer.Is_Equal(image.data()));
+  image[1023] |= 0x01;
+  REQUIRE(oled_buffer.Is_Equal(image.data()));
+}
+
+TEST_CASE( "copies overlapping regions")
+{
+  struct Copy
+  {
+    uint8_t x, y, width, height;
+    int16_t to_x, to_y;
+  };
+  const Copy copies[] = {
+      { 0, 8, 128, 48, 0, 0 },      //whole pages up
+      { 0, 0, 128, 48, 0, 16 },     //whole pages down
+      { 10, 16, 50, 16, 13, 16 },   //whole pages right
+      { 10, 3, 50, 20, 7, 0 },      //shifted up and left
+      { 10, 3, 50, 20, 12, 9 },     //shifted down and right
+      { 100, 50, 60, 30, 90, 40 },  //source clipped
+      { 20, 20, 30, 30, -10, -7 },  //destination clipped
+      { 0, 0, 128, 64, 0, 1 },      //whole display scrolled by one row
+      { 5, 5, 10, 10, 200, 5 },     //outside of display
+  };
+  std::vector<uint8_t> image(1024);
+  for (uint32_t i = 0; i < image.size(); i++)
+    {
+      image[i] = uint8_t(i * 37 + (i >> 3));
+    }
+
+  for (const Copy &copy : copies)
+    {
+      testing::ssd1306::panel.Reset();
+      oled_buffer.Initialize();
+      oled_buffer.Draw_Image(image.data());
+      oled_buffer.Update_Screen();
+
+      bool expected[64][128];
+      for (uint8_t y = 0; y < 64; y++)
+        {
+          for (uint8_t x = 0; x < 128; x++)
+            {
+              expected[y][x] = testing::ssd1306::panel.Pixel(x, y);
+            }
+        }
+      bool source[64][128];
+      std::copy(&expected[0][0], &expected[0][0] + 64 * 128, &source[0][0]);
+      for (int y = 0; y < copy.height; y++)
+        {
+          for (int x = 0; x < copy.width; x++)
+            {
+              int from_x = copy.x + x, from_y = copy.y + y;
+              int to_x = copy.to_x + x, to_y = copy.to_y + y;
+              if (from_x < 128 && from_y < 64 && to_x >= 0 && to_x < 128 && to_y >= 0 && to_y < 64)
+                {
+                  expected[to_y][to_x] = source[from_y][from_x];
+                }
+            }
+        }
+
+      oled_buffer.Copy_Region(copy.x, copy.y, copy.width, copy.height, copy.to_x, copy.to_y);
+      oled_buffer.Update_Dirty();
+      for (uint8_t y = 0; y < 64; y++)
+        {
+          for (uint8_t x = 0; x < 128; x++)
+            {
+              REQUIRE(testing::ssd1306::panel.Pixel(x, y) == expected[y][x]);
+            }
+        }
+    }
+}
+
+TEST_CASE( "benchmarks word-wide buffer operations", "[.][benchmark]")
+{
+  std::vector<uint8_t> image(1024, 0x55);
+  volatile bool equal = false;
+
+  BENCHMARK("byte by byte fill (reference)")
+  {
+    for (uint8_t &b : image)
+      {
+        b = SSD1306::Color::WHITE;
+      }
+  }
+  BENCHMARK("Fill")
+  {
+    oled_buffer.Fill(SSD1306::Color::WHITE);
+  }
+  BENCHMARK("Fill_Pattern")
+  {
+    oled_buffer.Fill_Pattern(0xAA55AA55);
+  }
+  BENCHMARK("Invert_Region of whole display")
+  {
+    oled_buffer.Invert_Region(0, 0, 128, 64);
+  }
+  BENCHMARK("Invert_Region of unaligned rectangle")
+  {
+    oled_buffer.Invert_Region(3, 5, 100, 50);
+  }
+  BENCHMARK("Fill_Rectangle solid")
+  {
+    oled_buffer.Fill_Rectangle(3, 5, 100, 50, SSD1306::Color::WHITE);
+  }
+  BENCHMARK("Fill_Rectangle with pattern")
+  {
+    oled_buffer.Fill_Rectangle(3, 5, 100, 50, Patterns::cross_hatch);
+  }
+  BENCHMARK("Copy_Region of whole pages")
+  {
+    oled_buffer.Copy_Region(0, 8, 128, 56, 0, 0);
+  }
+  BENCHMARK("Copy_Region scrolling by one row")
+  {
+    oled_buffer.Copy_Region(0, 1, 128, 63, 0, 0);
+  }
+  BENCHMARK("Is_Equal")
+  {
+    equal = oled_buffer.Is_Equal(image.data());
+  }
+  oled_buffer.Take_Snapshot(image.data());
+  oled_buffer.Set_Shadow(image.data());
+  BENCHMARK("Update_Changed of unchanged frame")
+  {
+    oled_buffer.Update_Changed();
+  }
+  oled_buffer.Set_Shadow(nullptr);
+  (void) equal;
+}
@@ -0,0 +1,167 @@
+/**
+ ******************************************************************************
+ * @file    SSD1306_controller_test.cpp
+ * @author  agent
+ * @date    17.10.2026
+ * @brief   Unit test for controllers compatible with SSD1306
+ ******************************************************************************
+ * <h2><center>&copy; COPYRIGHT(c) 2026 agent
+ * </center></h2>
+ *
+ *Permission is hereby granted, free of charge,
+ *to any person obtaining a copy of this software and associated documentation files
+ *(the "Software"), to deal in the Software without restriction,
+ *including without limitation the rights to use, copy, modify,
+ *merge, publish, distribute, sublicense, and/or sell copies of
+ *the Software, and to permit persons to whom the Software is furnished to do so,
+ *subject to the following conditions:
+ *
+ *The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ *THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ *INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ *PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ *FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************************************
+ */
+
+#include "catch.hpp"
+#include "SSD1306.hpp"
+#include "testing.hpp"
+#include "emulator.hpp"
+
+static constexpr SSD1306::Init_Sequence init_sh1106 = SSD1306::Make_Init_Sequence(
+    SSD1306::Default_Panel_Config(64, SSD1306::ALT_NOREMAP, SSD1306::CTRL_SH1106));
+
+TEST_CASE( "SH1106 initialization sequence uses page addressing")
+{
+  for (uint32_t i=22;i<init_sh1106.size();i++)//addressing part of sequence
+    {
+      REQUIRE(init_sh1106[i]!=0x20);//no memory addressing mode
+      REQUIRE(init_sh1106[i]!=0x21);//no column window
+      REQUIRE(init_sh1106[i]!=0x22);//no page window
+    }
+  REQUIRE(init_sh1106[8]==0xAD);//DC-DC
+  REQUIRE(init_sh1106[9]==0x8B);
+  REQUIRE(init_sh1106[19]==0x35);//vcomh
+  REQUIRE(init_sh1106[22]==0xB0);//page 0
+  REQUIRE(init_sh1106[23]==0x02);//column 2
+  REQUIRE(init_sh1106[24]==0x10);
+  REQUIRE(init_sh1106[25]==0xE3);//NOP
+}
+
+TEST_CASE( "SSD1309 and SSD1305 initialization sequences")
+{
+  SSD1306::Init_Sequence ssd1309 = SSD1306::Make_Init_Sequence(
+      SSD1306::Default_Panel_Config(64, SSD1306::ALT_NOREMAP, SSD1306::CTRL_SSD1309));
+  REQUIRE(ssd1309[8]==0xE3);//no charge pump
+  REQUIRE(ssd1309[9]==0xE3);
+  REQUIRE(ssd1309[17]==0x82);//pre-charge
+  REQUIRE(ssd1309[19]==0x34);//vcomh
+  REQUIRE(ssd1309[22]==0x20);//horizontal addressing
+  REQUIRE(ssd1309[23]==0x00);
+
+  SSD1306::Init_Sequence ssd1305 = SSD1306::Make_Init_Sequence(
+      SSD1306::Default_Panel_Config(32, SSD1306::ALT_NOREMAP, SSD1306::CTRL_SSD1305));
+  REQUIRE(ssd1305[2]==0xF0);//clock
+  REQUIRE(ssd1305[8]==0xAD);//master configuration
+  REQUIRE(ssd1305[9]==0x8F);
+  REQUIRE(ssd1305[29]==3);
+}
+
+TEST_CASE( "controller is taken from initialization sequence")
+{
+  const SSD1306::Controller controllers[] = { SSD1306::CTRL_SSD1306, SSD1306::CTRL_SH1106,
+      SSD1306::CTRL_SSD1309, SSD1306::CTRL_SSD1305 };
+  for (SSD1306::Controller controller : controllers)
+    {
+      SSD1306::Panel_Config config = SSD1306::Default_Panel_Config(64, SSD1306::ALT_NOREMAP, controller);
+      REQUIRE(SSD1306::Make_Init_Sequence(config).controller==controller);
+    }
+
+  //display made from SH1106 sequence uses page addressing
+  void *dummy;
+  SSD1306 sh1106(&dummy, init_sh1106);
+  testing::ssd1306::data.clear();
+  sh1106.Update_Region(0, 0, 8, 8);
+  REQUIRE(testing::ssd1306::data[0]==0xB0);
+}
+
+TEST_CASE( "SH1106 screen is updated page by page with column offset")
+{
+  void *dummy_sh1106;
+  SSD1306 sh1106(&dummy_sh1106, init_sh1106);
+  testing::ssd1306::panel.Reset(true);
+  sh1106.Initialize();
+
+  testing::ssd1306::data.clear();
+  sh1106.Draw_Pixel(0, 0, SSD1306::Color::WHITE);
+  sh1106.Draw_Pixel(127, 63, SSD1306::Color::WHITE);
+  sh1106.Draw_Pixel(5, 20, SSD1306::Color::WHITE);
+  sh1106.Update_Screen();
+
+  REQUIRE(testing::ssd1306::data.size()==8*(3+128));
+  REQUIRE(testing::ssd1306::data[0]==0xB0);
+  REQUIRE(testing::ssd1306::data[1]==0x02);
+  REQUIRE(testing::ssd1306::data[2]==0x10);
+  REQUIRE(testing::ssd1306::data[3]==0x01);
+  REQUIRE(testing::ssd1306::data[131]==0xB1);
+
+  REQUIRE(testing::ssd1306::panel.Ram(2, 0)==0x01);
+  REQUIRE(testing::ssd1306::panel.Ram(0, 0)==0);
+  for (uint8_t y=0;y<64;y++)
+    {
+      for (uint8_t x=0;x<128;x++)
+        {
+          bool expected = (x==0 && y==0) || (x==127 && y==63) || (x==5 && y==20);
+          REQUIRE(testing::ssd1306::panel.Pixel(x, y)==expected);
+        }
+    }
+}
+
+TEST_CASE( "SH1106 region update sets column for each page")
+{
+  void *dummy_sh1106;
+  SSD1306 sh1106(&dummy_sh1106, 64, SSD1306::ALT_NOREMAP, 0x78, SSD1306::CTRL_SH1106);
+  testing::ssd1306::panel.Reset(true);
+  sh1106.Initialize();
+
+  testing::ssd1306::data.clear();
+  sh1106.Draw_Pixel(20, 9, SSD1306::Color::WHITE);
+  sh1106.Update_Region(20, 6, 3, 4);
+
+  REQUIRE(testing::ssd1306::data.size()==2*(3+3));
+  REQUIRE(testing::ssd1306::data[0]==0xB0);
+  REQUIRE(testing::ssd1306::data[1]==0x06);//column 22
+  REQUIRE(testing::ssd1306::data[2]==0x11);
+  REQUIRE(testing::ssd1306::data[6]==0xB1);
+  REQUIRE(testing::ssd1306::data[9]==0x02);
+  REQUIRE(testing::ssd1306::panel.Pixel(20, 9));
+  REQUIRE_FALSE(testing::ssd1306::panel.Pixel(21, 9));
+}
+
+TEST_CASE( "horizontal addressing shows the same image as page addressing")
+{
+  void *dummy_ssd;
+  SSD1306 ssd1306(&dummy_ssd, 32, SSD1306::SEQ_NOREMAP);
+  testing::ssd1306::panel.Reset(false, 32);
+  ssd1306.Initialize();
+
+  ssd1306.Draw_Square(3, 2, 40, 30, SSD1306::Color::WHITE);
+  ssd1306.Update_Region(0, 0, 64, 32);
+  ssd1306.Draw_Line_H(100, 10, 20, SSD1306::Color::WHITE);
+  ssd1306.Update_Region(100, 10, 20, 1);
+
+  for (uint8_t y=0;y<32;y++)
+    {
+      for (uint8_t x=0;x<128;x++)
+        {
+          bool square = ((x==3 || x==40) && y>=2 && y<=30) || ((y==2 || y==30) && x>=3 && x<=40);
+          bool line = y==10 && x>=100 && x<120;
+          REQUIRE(testing::ssd1306::panel.Pixel(x, y)==(square || line));
+        }
+    }
+}
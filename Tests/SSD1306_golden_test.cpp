@@ -0,0 +1,131 @@
+/**
+ ******************************************************************************
+ * @file    SSD1306_golden_test.cpp
+ * @author  agent
+ * @date    17.10.2026
+ * @brief   Regression tests of rendered scenes against golden images
+ ******************************************************************************
+ * <h2><center>&copy; COPYRIGHT(c) 2026 agent
+ * </center></h2>
+ *
+ *Permission is hereby granted, free of charge,
+ *to any person obtaining a copy of this software and associated documentation files
+ *(the "Software"), to deal in the Software without restriction,
+ *including without limitation the rights to use, copy, modify,
+ *merge, publish, distribute, sublicense, and/or sell copies of
+ *the Software, and to permit persons to whom the Software is furnished to do so,
+ *subject to the following conditions:
+ *
+ *The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ *THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ *INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ *PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ *FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************************************
+ */
+
+#include <vector>
+#include "catch.hpp"
+#include "SSD1306.hpp"
+#include "testing.hpp"
+#include "emulator.hpp"
+#include "golden.hpp"
+
+namespace
+{
+  void *dummy_golden;
+  SSD1306 oled_golden(&dummy_golden, 64);
+
+  /// Display is initialized, cleared and shown on fresh panel
+  void Start_Scene(void)
+  {
+    testing::ssd1306::panel.Reset();
+    oled_golden.Initialize();
+    oled_golden.Clean();
+  }
+
+  /// Buffer and panel have to show the same golden image
+  void Check_Scene(const char *name)
+  {
+    oled_golden.Update_Screen();
+    CHECK(testing::golden::Compare(name, testing::golden::Buffer_Image(oled_golden)) == "");
+    CHECK(testing::golden::Compare(name, testing::golden::Panel_Image()) == "");
+  }
+}
+
+TEST_CASE( "golden: text in all fonts")
+{
+  Start_Scene();
+  oled_golden.Set_Font_size(Fonts::font_7x10);
+  oled_golden.Set_Cursor(0, 0);
+  oled_golden.Write_String("Hello, 7x10!");
+  oled_golden.Set_Font_size(Fonts::font_11x18);
+  oled_golden.Set_Cursor(0, 12);
+  oled_golden.Write_String_Inverted("11x18");
+  oled_golden.Set_Font_size(Fonts::font_16x26);
+  oled_golden.Set_Cursor(0, 34);
+  oled_golden.Write_String("16x26");
+  oled_golden.Set_Font_size(Fonts::font_7x10);
+  Check_Scene("text");
+}
+
+TEST_CASE( "golden: outlines and filled shapes")
+{
+  Start_Scene();
+  oled_golden.Draw_Square(0, 0, 127, 63, SSD1306::Color::WHITE);
+  oled_golden.Draw_Line_H(4, 31, 56, SSD1306::Color::WHITE);
+  oled_golden.Draw_Line_V(63, 4, 56, SSD1306::Color::WHITE);
+  oled_golden.Fill_Circle(32, 16, 10, SSD1306::Color::WHITE);
+  oled_golden.Fill_Circle(32, 48, 10, Patterns::gray_25);
+  const SSD1306::Point star[] = { { 96, 4 }, { 104, 26 }, { 84, 12 }, { 108, 12 }, { 88, 26 } };
+  oled_golden.Fill_Polygon(star, 5, SSD1306::Color::WHITE);
+  oled_golden.Fill_Rectangle(70, 36, 50, 22, Patterns::diagonal);
+  oled_golden.Invert_Region(80, 40, 30, 14);
+  Check_Scene("shapes");
+}
+
+TEST_CASE( "golden: patterns")
+{
+  Start_Scene();
+  const Patterns::PatternDef *patterns[] = { &Patterns::checker, &Patterns::diagonal, &Patterns::back_diagonal,
+      &Patterns::cross_hatch, &Patterns::dots, &Patterns::gray_12, &Patterns::gray_25, &Patterns::gray_75 };
+  for (uint8_t i = 0; i < 8; i++)
+    {
+      oled_golden.Fill_Rectangle(uint8_t(1 + (i % 4) * 32), uint8_t(1 + (i / 4) * 32), 30, 30, *patterns[i]);
+    }
+  Check_Scene("patterns");
+}
+
+TEST_CASE( "golden: flipped screen is shown upside down on panel")
+{
+  Start_Scene();
+  oled_golden.Set_Cursor(2, 2);
+  oled_golden.Write_String("top");
+  oled_golden.Fill_Rectangle(100, 50, 20, 10, SSD1306::Color::WHITE);
+  oled_golden.Flip_Screen(true);
+  oled_golden.Update_Screen();
+  CHECK(testing::golden::Compare("flip_buffer", testing::golden::Buffer_Image(oled_golden)) == "");
+  CHECK(testing::golden::Compare("flip_panel", testing::golden::Panel_Image()) == "");
+  oled_golden.Flip_Screen(false);
+}
+
+TEST_CASE( "golden harness reports differences")
+{
+  std::vector<uint8_t> image(1024, 0);
+  image[0] = 0x81;
+  std::vector<uint8_t> parsed;
+  REQUIRE(testing::golden::From_Pbm(testing::golden::To_Plain_Pbm(image), parsed));
+  REQUIRE(parsed == image);
+  REQUIRE_FALSE(testing::golden::From_Pbm("P1\n8 8\n", parsed));
+
+  std::vector<uint8_t> golden = image;
+  REQUIRE(testing::golden::Diff(image, golden) == "");
+  image[5] = 0x40; //pixel 5,6 is lit
+  image[7] = 0x40;
+  golden[6] = 0x40;
+  REQUIRE(testing::golden::Diff(image, golden) == "3 pixels differ in x 5-7, y 6-6\n+-+\n");
+}
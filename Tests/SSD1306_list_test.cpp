@@ -0,0 +1,194 @@
+/**
+ ******************************************************************************
+ * @file    SSD1306_list_test.cpp
+ * @author  agent
+ * @date    17.10.2026
+ * @brief   Unit test for scrolling list widget
+ ******************************************************************************
+ * <h2><center>&copy; COPYRIGHT(c) 2026 agent
+ * </center></h2>
+ *
+ *Permission is hereby granted, free of charge,
+ *to any person obtaining a copy of this software and associated documentation files
+ *(the "Software"), to deal in the Software without restriction,
+ *including without limitation the rights to use, copy, modify,
+ *merge, publish, distribute, sublicense, and/or sell copies of
+ *the Software, and to permit persons to whom the Software is furnished to do so,
+ *subject to the following conditions:
+ *
+ *The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ *THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ *INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ *PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ *FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************************************
+ */
+
+#include <stdio.h>
+#include <vector>
+#include "catch.hpp"
+#include "SSD1306.hpp"
+#include "SSD1306_list.hpp"
+#include "testing.hpp"
+#include "emulator.hpp"
+
+namespace
+{
+  void *dummy_list;
+  SSD1306 oled_list(&dummy_list, 64);
+
+  std::vector<uint16_t> drawn_items;
+
+  const char *Item(void *context, uint16_t index)
+  {
+    static char text[16];
+    REQUIRE(context == &drawn_items);
+    drawn_items.push_back(index);
+    snprintf(text, sizeof(text), "Item %u", unsigned(index));
+    return text;
+  }
+
+  std::vector<bool> Panel_Pixels(void)
+  {
+    std::vector<bool> pixels;
+    for (uint8_t y = 0; y < 64; y++)
+      {
+        for (uint8_t x = 0; x < 128; x++)
+          {
+            pixels.push_back(testing::ssd1306::panel.Pixel(x, y));
+          }
+      }
+    return pixels;
+  }
+
+  /// What panel shows if list in given state is drawn from scratch
+  std::vector<bool> Drawn_From_Scratch(uint16_t selected, uint16_t first)
+  {
+    oled_list.Clean();
+    SSD1306_List list(oled_list, Item, &drawn_items, 300, 0, 2, 100, 62);
+    list.Select(uint16_t(first + list.Get_Visible_Rows() - 1));
+    list.Select(selected);
+    REQUIRE(list.Get_First_Visible() == first);
+    list.Draw();
+    oled_list.Update_Dirty();
+    return Panel_Pixels();
+  }
+}
+
+TEST_CASE( "list draws only visible rows and scrolls by copying them")
+{
+  testing::ssd1306::panel.Reset();
+  oled_list.Initialize();
+  SSD1306_List list(oled_list, Item, &drawn_items, 300, 0, 2, 100, 62);
+  REQUIRE(list.Get_Visible_Rows() == 5); //rows of 12 pixels
+
+  drawn_items.clear();
+  list.Draw();
+  oled_list.Update_Dirty();
+  REQUIRE(drawn_items == std::vector<uint16_t>({0, 1, 2, 3, 4}));
+  REQUIRE(testing::ssd1306::panel.Pixel(50, 2)); //selection bar of first row
+  REQUIRE(testing::ssd1306::panel.Pixel(99, 13));
+  REQUIRE_FALSE(testing::ssd1306::panel.Pixel(100, 2));
+  REQUIRE_FALSE(testing::ssd1306::panel.Pixel(50, 14));
+
+  // moving selection within visible rows draws no item, only two rows are sent
+  drawn_items.clear();
+  testing::ssd1306::data.clear();
+  list.Next();
+  oled_list.Update_Dirty();
+  REQUIRE(drawn_items.empty());
+  REQUIRE(testing::ssd1306::data.size() == 6 + 4 * 100); //rows 2-25 are in pages 0-3
+  REQUIRE(testing::ssd1306::panel.Pixel(50, 14));
+  REQUIRE_FALSE(testing::ssd1306::panel.Pixel(50, 13));
+
+  for (uint8_t i = 0; i < 3; i++)
+    {
+      list.Next();
+    }
+  REQUIRE(drawn_items.empty());
+  list.Next(); //scrolls by one row, only new item is drawn
+  REQUIRE(drawn_items == std::vector<uint16_t>({5}));
+  REQUIRE(list.Get_First_Visible() == 1);
+  oled_list.Update_Dirty();
+  std::vector<bool> scrolled = Panel_Pixels();
+  REQUIRE(scrolled == Drawn_From_Scratch(5, 1));
+
+  oled_list.Draw_Image(std::vector<uint8_t>(1024, 0).data());
+  list.Draw();
+  list.Select(8);
+  drawn_items.clear();
+  list.Select(2); //scrolls back by two rows
+  REQUIRE(drawn_items == std::vector<uint16_t>({2, 3}));
+  oled_list.Update_Dirty();
+  scrolled = Panel_Pixels();
+  REQUIRE(scrolled == Drawn_From_Scratch(2, 2));
+}
+
+TEST_CASE( "list jumps and limits selection")
+{
+  testing::ssd1306::panel.Reset();
+  oled_list.Initialize();
+  SSD1306_List list(oled_list, Item, &drawn_items, 300, 0, 2, 100, 62);
+  list.Draw();
+
+  drawn_items.clear();
+  list.Select(200); //far jump draws all rows
+  REQUIRE(drawn_items == std::vector<uint16_t>({196, 197, 198, 199, 200}));
+  oled_list.Update_Dirty();
+  REQUIRE(Panel_Pixels() == Drawn_From_Scratch(200, 196));
+
+  list.Select(1000);
+  REQUIRE(list.Get_Selected() == 299);
+  list.Next();
+  REQUIRE(list.Get_Selected() == 299);
+
+  list.Set_Count(3); //rows without items are empty
+  REQUIRE(list.Get_Selected() == 2);
+  REQUIRE(list.Get_First_Visible() == 2);
+  list.Previous();
+  list.Previous();
+  list.Previous();
+  REQUIRE(list.Get_Selected() == 0);
+  REQUIRE(list.Get_First_Visible() == 0);
+
+  list.Set_Count(0);
+  list.Draw();
+  oled_list.Update_Dirty();
+  for (uint8_t y = 0; y < 64; y++)
+    {
+      for (uint8_t x = 0; x < 128; x++)
+        {
+          REQUIRE_FALSE(testing::ssd1306::panel.Pixel(x, y));
+        }
+    }
+}
+
+static const char *Fixed_Text(void *context, uint16_t)
+{
+  return static_cast<const char*>(context);
+}
+
+TEST_CASE( "list keeps font of display and draws unknown characters as question mark")
+{
+  testing::ssd1306::panel.Reset();
+  oled_list.Initialize();
+  oled_list.Set_Font_size(Fonts::font_11x18);
+  char question[] = "A?B";
+  SSD1306_List expected(oled_list, Fixed_Text, question, 1);
+  expected.Draw();
+  oled_list.Update_Dirty();
+  std::vector<bool> pixels = Panel_Pixels();
+  REQUIRE(oled_list.Get_Font_size().FontWidth == 11);
+
+  char control[] = "A\tB";
+  SSD1306_List list(oled_list, Fixed_Text, control, 1);
+  list.Draw();
+  oled_list.Update_Dirty();
+  REQUIRE(Panel_Pixels() == pixels);
+  REQUIRE(oled_list.Get_Font_size().FontWidth == 11);
+  oled_list.Set_Font_size(Fonts::font_7x10);
+}
@@ -0,0 +1,180 @@
+/**
+ ******************************************************************************
+ * @file    SSD1306_mirror_test.cpp
+ * @author  agent
+ * @date    17.10.2026
+ * @brief   Unit test for streaming of display content
+ ******************************************************************************
+ * <h2><center>&copy; COPYRIGHT(c) 2026 agent
+ * </center></h2>
+ *
+ *Permission is hereby granted, free of charge,
+ *to any person obtaining a copy of this software and associated documentation files
+ *(the "Software"), to deal in the Software without restriction,
+ *including without limitation the rights to use, copy, modify,
+ *merge, publish, distribute, sublicense, and/or sell copies of
+ *the Software, and to permit persons to whom the Software is furnished to do so,
+ *subject to the following conditions:
+ *
+ *The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ *THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ *INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ *PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ *FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************************************
+ */
+
+#include <unistd.h>
+#include <vector>
+#include "catch.hpp"
+#include "SSD1306.hpp"
+#include "SSD1306_mirror.hpp"
+#include "SSD1306_snapshot.hpp"
+
+namespace
+{
+  void *dummy_mirror;
+  SSD1306 oled_mirror(&dummy_mirror, 64);
+
+  /// Local pipe standing for UART or TCP connection
+  struct Pipe
+  {
+    int fd[2] = { -1, -1 };
+    uint32_t written = 0;
+    bool fail_next = false; ///<next write fails without writing anything
+
+    Pipe()
+    {
+      REQUIRE(pipe(fd) == 0);
+    }
+    ~Pipe()
+    {
+      close(fd[0]);
+      close(fd[1]);
+    }
+
+    static bool Write(void *context, const uint8_t *data, uint16_t size)
+    {
+      Pipe &self = *static_cast<Pipe*>(context);
+      if (self.fail_next)
+        {
+          self.fail_next = false;
+          return false;
+        }
+      self.written += size;
+      return write(self.fd[1], data, size) == size;
+    }
+
+    /// Everything written since last call
+    std::vector<uint8_t> Read(void)
+    {
+      std::vector<uint8_t> bytes(written);
+      uint32_t n = 0;
+      while (n < written)
+        {
+          ssize_t got = read(fd[0], bytes.data() + n, written - n);
+          REQUIRE(got > 0);
+          n += uint32_t(got);
+        }
+      written = 0;
+      return bytes;
+    }
+  };
+
+  std::vector<uint8_t> Pbm_Of(const uint8_t *image)
+  {
+    std::vector<uint8_t> pbm(SSD1306_Snapshot::pbm_size);
+    pbm.resize(SSD1306_Snapshot::Encode_Pbm(image, pbm.data()));
+    return pbm;
+  }
+
+  std::vector<uint8_t> Display_Pbm(void)
+  {
+    std::vector<uint8_t> image(SSD1306_Snapshot::size);
+    oled_mirror.Take_Snapshot(image.data());
+    return Pbm_Of(image.data());
+  }
+}
+
+TEST_CASE( "mirror streams keyframe and deltas over pipe")
+{
+  oled_mirror.Initialize();
+  Pipe pipe;
+  SSD1306_Mirror mirror(oled_mirror, Pipe::Write, &pipe, 3);
+  SSD1306_Mirror::Decoder decoder;
+  oled_mirror.Clean();
+  oled_mirror.Fill_Circle(64, 32, 20, SSD1306::Color::WHITE);
+  oled_mirror.Update_Screen();
+  std::vector<uint8_t> stream = pipe.Read();
+  REQUIRE(stream.size() == 5 + 8 * (3 + 128) + 1);
+  REQUIRE(stream[1] == SSD1306_Mirror::keyframe);
+  REQUIRE(decoder.Feed(stream.data(), uint32_t(stream.size())) == 1);
+  REQUIRE(decoder.Is_Synchronized());
+  REQUIRE(Pbm_Of(decoder.Image()) == Display_Pbm());
+
+  oled_mirror.Fill_Rectangle(10, 10, 5, 12, SSD1306::Color::WHITE);
+  oled_mirror.Update_Dirty(); //pages 1-2 of 5 columns
+  stream = pipe.Read();
+  REQUIRE(stream.size() == 5 + 2 * (3 + 5) + 1);
+  REQUIRE(stream[1] == SSD1306_Mirror::delta);
+  REQUIRE(decoder.Feed(stream.data(), uint32_t(stream.size())) == 1);
+  REQUIRE(Pbm_Of(decoder.Image()) == Display_Pbm());
+
+  oled_mirror.Draw_Pixel(100, 60, SSD1306::Color::WHITE);
+  oled_mirror.Update_Dirty();
+  oled_mirror.Draw_Pixel(101, 60, SSD1306::Color::WHITE);
+  oled_mirror.Update_Dirty(); //third packet is keyframe
+  stream = pipe.Read();
+  REQUIRE(stream.size() == (5 + 3 + 1 + 1) + (5 + 8 * (3 + 128) + 1));
+  REQUIRE(decoder.Feed(stream.data(), uint32_t(stream.size())) == 2);
+  REQUIRE(Pbm_Of(decoder.Image()) == Display_Pbm());
+  REQUIRE(decoder.Get_Errors() == 0);
+}
+
+TEST_CASE( "mirror recovers from lost and corrupted packets with keyframe")
+{
+  Pipe pipe;
+  SSD1306_Mirror mirror(oled_mirror, Pipe::Write, &pipe, 0);
+  SSD1306_Mirror::Decoder decoder;
+  oled_mirror.Clean();
+  oled_mirror.Update_Screen();
+  std::vector<uint8_t> stream = pipe.Read();
+  stream.insert(stream.begin(), { 0x00, SSD1306_Mirror::sync, 0x12 }); //noise before packet
+  REQUIRE(decoder.Feed(stream.data(), uint32_t(stream.size())) == 1);
+
+  oled_mirror.Draw_Pixel(1, 1, SSD1306::Color::WHITE);
+  oled_mirror.Update_Dirty();
+  stream = pipe.Read();
+  stream[5 + 3] ^= 0x01; //corrupted payload
+  REQUIRE(decoder.Feed(stream.data(), uint32_t(stream.size())) == 0);
+  REQUIRE_FALSE(decoder.Is_Synchronized());
+  REQUIRE(decoder.Get_Errors() == 1);
+
+  oled_mirror.Draw_Pixel(2, 2, SSD1306::Color::WHITE);
+  oled_mirror.Update_Dirty();
+  stream = pipe.Read();
+  REQUIRE(stream[1] == SSD1306_Mirror::delta);
+  REQUIRE(decoder.Feed(stream.data(), uint32_t(stream.size())) == 0); //deltas are ignored until keyframe
+
+  mirror.Request_Keyframe();
+  oled_mirror.Update_Region(0, 0, 1, 1);
+  stream = pipe.Read();
+  REQUIRE(stream[1] == SSD1306_Mirror::keyframe);
+  REQUIRE(decoder.Feed(stream.data(), uint32_t(stream.size())) == 1);
+  REQUIRE(Pbm_Of(decoder.Image()) == Display_Pbm());
+
+  pipe.fail_next = true; //header of packet is not written
+  oled_mirror.Draw_Pixel(3, 3, SSD1306::Color::WHITE);
+  oled_mirror.Update_Dirty();
+  oled_mirror.Draw_Pixel(4, 4, SSD1306::Color::WHITE);
+  oled_mirror.Update_Dirty(); //keyframe after failed write
+  stream = pipe.Read();
+  REQUIRE(stream[1] == SSD1306_Mirror::keyframe);
+  REQUIRE(decoder.Feed(stream.data(), uint32_t(stream.size())) == 1);
+  REQUIRE(Pbm_Of(decoder.Image()) == Display_Pbm());
+  REQUIRE(decoder.Is_Synchronized());
+}
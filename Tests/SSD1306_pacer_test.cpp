@@ -0,0 +1,155 @@
+/**
+ ******************************************************************************
+ * @file    SSD1306_pacer_test.cpp
+ * @author  agent
+ * @date    17.10.2026
+ * @brief   Unit test for clock settings and frame pacing
+ ******************************************************************************
+ * <h2><center>&copy; COPYRIGHT(c) 2026 agent
+ * </center></h2>
+ *
+ *Permission is hereby granted, free of charge,
+ *to any person obtaining a copy of this software and associated documentation files
+ *(the "Software"), to deal in the Software without restriction,
+ *including without limitation the rights to use, copy, modify,
+ *merge, publish, distribute, sublicense, and/or sell copies of
+ *the Software, and to permit persons to whom the Software is furnished to do so,
+ *subject to the following conditions:
+ *
+ *The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ *THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ *INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ *PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ *FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************************************
+ */
+
+#include "catch.hpp"
+#include "SSD1306.hpp"
+#include "SSD1306_pacer.hpp"
+#include "testing.hpp"
+
+static uint32_t time_us = 0;
+
+static uint32_t Fake_Time(void)
+{
+  return time_us;
+}
+
+static_assert(SSD1306::Frame_Period_Us(0x80, 0x22, 64) == 9340, "default 128x64 refresh");
+static_assert(SSD1306::Frame_Period_Us(0x80, 0x22, 32) == 4670, "default 128x32 refresh");
+
+TEST_CASE( "frame period follows clock settings")
+{
+  void *dummy;
+  SSD1306 oled(&dummy, 64);
+  oled.Initialize();
+  REQUIRE(oled.Get_Frame_Period_Us()==9340);
+
+  testing::ssd1306::data.clear();
+  oled.Set_Clock(2, 15);
+  REQUIRE(testing::ssd1306::data.size()==2);
+  REQUIRE(testing::ssd1306::data[0]==0xD5);
+  REQUIRE(testing::ssd1306::data[1]==0xF1);
+  REQUIRE(oled.Get_Frame_Period_Us()==12776);//2*54*64/541kHz
+
+  testing::ssd1306::data.clear();
+  oled.Set_Clock(0, 20);//out of range values are limited
+  REQUIRE(testing::ssd1306::data[1]==0xF0);
+
+  constexpr SSD1306::Init_Sequence slow =
+      SSD1306::Make_Init_Sequence({32, SSD1306::SEQ_NOREMAP, true, 0xF1, 0x40, 0x00});
+  SSD1306 oled32(&dummy, slow);
+  oled32.Initialize();
+  REQUIRE(oled32.Get_Frame_Period_Us()==SSD1306::Frame_Period_Us(0x00, 0xF1, 32));
+}
+
+TEST_CASE( "frames are sent right after scan boundary")
+{
+  void *dummy;
+  SSD1306 oled(&dummy, 64);
+  oled.Initialize();
+  SSD1306_Frame_Pacer pacer(oled, Fake_Time);
+  time_us = 1000;
+  pacer.Synchronize();
+
+  testing::ssd1306::data.clear();
+  REQUIRE_FALSE(pacer.Poll());//nothing submitted
+  pacer.Submit();
+  time_us = 1000 + 9340 / 2;//middle of scan
+  REQUIRE_FALSE(pacer.Is_Frame_Due());
+  REQUIRE_FALSE(pacer.Poll());
+  REQUIRE(testing::ssd1306::data.empty());
+
+  time_us = 1000 + 9340 * 3 + 100;//just after boundary
+  REQUIRE(pacer.Poll());
+  REQUIRE(testing::ssd1306::data.size()==6+1024);
+  REQUIRE_FALSE(pacer.Poll());//already sent
+  REQUIRE(pacer.Get_Sent_Frames()==1);
+}
+
+TEST_CASE( "time source can wrap around")
+{
+  void *dummy;
+  SSD1306 oled(&dummy, 64);
+  oled.Initialize();
+  SSD1306_Frame_Pacer pacer(oled, Fake_Time);
+  time_us = 0xFFFFFFFF - 100;
+  pacer.Synchronize();
+  pacer.Submit();
+  time_us = 9340 - 101 + 50;//boundary after wrap + 50us
+  REQUIRE(pacer.Poll());
+}
+
+TEST_CASE( "scan phase is kept when elapsed time exceeds range of time source")
+{
+  void *dummy;
+  SSD1306 oled(&dummy, 64);
+  oled.Initialize();
+  SSD1306_Frame_Pacer pacer(oled, Fake_Time);
+  time_us = 1000;
+  pacer.Synchronize();
+  for (uint32_t i = 1; i <= 3; i++)//400000 frames take 3736 s, so clock wraps around between them
+    {
+      uint32_t boundary = 1000 + i * 400000 * 9340;
+      pacer.Submit();
+      time_us = boundary - 100;//end of previous scan
+      REQUIRE_FALSE(pacer.Poll());
+      time_us = boundary + 100;
+      REQUIRE(pacer.Poll());
+    }
+}
+
+TEST_CASE( "frame rate limit drops intermediate frames")
+{
+  void *dummy;
+  SSD1306 oled(&dummy, 64);
+  oled.Initialize();
+  SSD1306_Frame_Pacer pacer(oled, Fake_Time, 10);//100ms between frames
+  time_us = 0;
+  pacer.Synchronize();
+
+  pacer.Submit();
+  REQUIRE(pacer.Poll());
+  for (uint32_t frame = 1; frame < 10; frame++)//new frame on each panel scan
+    {
+      time_us = frame * 9340 + 10;
+      pacer.Submit();
+      REQUIRE_FALSE(pacer.Poll());
+    }
+  REQUIRE(pacer.Get_Dropped_Frames()==8);
+  time_us = 11 * 9340 + 10;
+  REQUIRE(pacer.Poll());
+  REQUIRE(pacer.Get_Sent_Frames()==2);
+
+  pacer.Set_Max_Fps(0);
+  pacer.Submit();
+  time_us = 12 * 9340 + 10;
+  pacer.Mark_Sent();//sent by other means
+  REQUIRE_FALSE(pacer.Is_Frame_Due());
+  REQUIRE(pacer.Get_Sent_Frames()==3);
+}
@@ -0,0 +1,253 @@
+/**
+ ******************************************************************************
+ * @file    SSD1306_recovery_test.cpp
+ * @author  agent
+ * @date    17.10.2026
+ * @brief   Unit test for dirty tracking and recovery from bus errors
+ ******************************************************************************
+ * <h2><center>&copy; COPYRIGHT(c) 2026 agent
+ * </center></h2>
+ *
+ *Permission is hereby granted, free of charge,
+ *to any person obtaining a copy of this software and associated documentation files
+ *(the "Software"), to deal in the Software without restriction,
+ *including without limitation the rights to use, copy, modify,
+ *merge, publish, distribute, sublicense, and/or sell copies of
+ *the Software, and to permit persons to whom the Software is furnished to do so,
+ *subject to the following conditions:
+ *
+ *The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ *THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ *INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ *PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ *FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************************************
+ */
+
+#include <vector>
+#include "catch.hpp"
+#include "SSD1306.hpp"
+#include "testing.hpp"
+#include "emulator.hpp"
+
+namespace
+{
+  void *dummy_recovery;
+  SSD1306 oled_recovery(&dummy_recovery, 64);
+
+  uint32_t bus_resets;
+  std::vector<uint32_t> delays;
+
+  void Bus_Reset(void *context)
+  {
+    REQUIRE(context == &dummy_recovery);
+    bus_resets++;
+  }
+
+  void Delay(void *context, uint32_t us)
+  {
+    (void) context;
+    delays.push_back(us);
+  }
+
+  void Require_Panel_Shows_Buffer(const uint8_t *expected_rows)
+  {
+    for (uint8_t y=0;y<64;y++)
+      {
+        for (uint8_t x=0;x<128;x++)
+          {
+            REQUIRE(testing::ssd1306::panel.Pixel(x, y)==(expected_rows[y] > x));
+          }
+      }
+  }
+}
+
+TEST_CASE( "only changed columns are sent by dirty update")
+{
+  testing::ssd1306::panel.Reset();
+  oled_recovery.Initialize();
+  testing::ssd1306::data.clear();
+  oled_recovery.Update_Dirty();
+  REQUIRE(testing::ssd1306::data.empty());//everything was sent by Initialize
+
+  oled_recovery.Draw_Pixel(10, 3, SSD1306::Color::WHITE);
+  oled_recovery.Draw_Pixel(20, 3, SSD1306::Color::WHITE);
+  oled_recovery.Draw_Pixel(5, 20, SSD1306::Color::WHITE);
+  oled_recovery.Update_Dirty();
+  REQUIRE(testing::ssd1306::data == std::vector<uint8_t>({0x21, 10, 20, 0x22, 0, 0, //page 0
+      0x08, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x08,
+      0x21, 5, 5, 0x22, 2, 2, //page 2
+      0x10}));
+
+  testing::ssd1306::data.clear();
+  oled_recovery.Update_Dirty();
+  REQUIRE(testing::ssd1306::data.empty());
+
+  oled_recovery.Draw_Pixel(0, 0, SSD1306::Color::WHITE);
+  oled_recovery.Update_Screen();//update of whole page clears its changes
+  testing::ssd1306::data.clear();
+  oled_recovery.Update_Dirty();
+  REQUIRE(testing::ssd1306::data.empty());
+}
+
+TEST_CASE( "NACK in the middle of frame marks rest of window for retransmission")
+{
+  testing::ssd1306::panel.Reset();
+  oled_recovery.Initialize();
+  uint8_t rows[64] = { };
+  for (uint8_t y=0;y<64;y++)
+    {
+      rows[y] = 100;
+      oled_recovery.Draw_Line_H(0, y, 100, SSD1306::Color::WHITE);
+    }
+
+  testing::ssd1306::data.clear();
+  testing::ssd1306::Inject_Nack(6+250);//in third page
+  oled_recovery.Update_Region(0, 0, 100, 64);
+  REQUIRE(oled_recovery.Get_Last_Error()==SSD1306::ERROR_NACK);
+  REQUIRE(testing::ssd1306::data.size()==6+250);//transfer is not continued
+  oled_recovery.Clean_Errors();
+
+  testing::ssd1306::data.clear();
+  oled_recovery.Update_Dirty();
+  REQUIRE(testing::ssd1306::data.size()==6+6*100);//pages 2 to 7
+  REQUIRE(testing::ssd1306::data[4]==2);
+  REQUIRE(testing::ssd1306::data[5]==7);
+  REQUIRE(oled_recovery.Get_Last_Error()==0);
+  Require_Panel_Shows_Buffer(rows);
+}
+
+TEST_CASE( "failed commands force addressing mode to be sent again")
+{
+  testing::ssd1306::panel.Reset();
+  oled_recovery.Initialize();
+  oled_recovery.Draw_Line_V(5, 0, 64, SSD1306::Color::WHITE);
+
+  testing::ssd1306::Inject_Nack(1);//vertical mode is not set
+  oled_recovery.Update_Region(5, 0, 1, 64);
+  REQUIRE(testing::ssd1306::panel.addressing_mode==0);
+  oled_recovery.Clean_Errors();
+
+  testing::ssd1306::data.clear();
+  oled_recovery.Draw_Line_V(100, 0, 64, SSD1306::Color::WHITE);
+  oled_recovery.Update_Region(100, 0, 1, 64);
+  REQUIRE(testing::ssd1306::data[0]==0x20);
+  REQUIRE(testing::ssd1306::data[1]==0x01);
+
+  oled_recovery.Update_Dirty();
+  for (uint8_t y=0;y<64;y++)
+    {
+      REQUIRE(testing::ssd1306::panel.Pixel(5, y));
+      REQUIRE(testing::ssd1306::panel.Pixel(100, y));
+      REQUIRE_FALSE(testing::ssd1306::panel.Pixel(6, y));
+    }
+}
+
+TEST_CASE( "transfers are retried with backoff and bus reset")
+{
+  testing::ssd1306::panel.Reset();
+  oled_recovery.Initialize();
+  SSD1306::Retry_Policy policy;
+  policy.attempts = 4;
+  policy.backoff_us = 100;
+  policy.max_backoff_us = 300;
+  policy.delay_us = Delay;
+  policy.bus_reset = Bus_Reset;
+  policy.context = &dummy_recovery;
+  oled_recovery.Set_Retry_Policy(policy);
+  bus_resets = 0;
+  delays.clear();
+
+  uint8_t rows[64] = { };
+  rows[30] = 128;
+  oled_recovery.Draw_Line_H(0, 30, 128, SSD1306::Color::WHITE);
+  testing::ssd1306::Inject_Nack(6+500, 3);
+  oled_recovery.Update_Screen();
+  REQUIRE(oled_recovery.Get_Last_Error()==0);//recovered error is not reported
+  REQUIRE(bus_resets==3);
+  REQUIRE(delays == std::vector<uint32_t>({100, 200, 300}));
+  Require_Panel_Shows_Buffer(rows);
+
+  testing::ssd1306::Inject_Nack(6+500, 4);//all attempts fail
+  oled_recovery.Update_Screen();
+  REQUIRE(oled_recovery.Get_Last_Error()==SSD1306::ERROR_NACK);
+  oled_recovery.Clean_Errors();
+  oled_recovery.Set_Retry_Policy(SSD1306::Retry_Policy());
+}
+
+static uint32_t statistics_time = 0;
+
+static uint32_t Statistics_Clock(void)
+{
+  statistics_time += 1000;//each reading takes 1ms
+  return statistics_time;
+}
+
+TEST_CASE( "statistics count errors, retries and frame times")
+{
+  testing::ssd1306::panel.Reset();
+  oled_recovery.Initialize();
+  SSD1306::Retry_Policy policy;
+  policy.attempts = 2;
+  oled_recovery.Set_Retry_Policy(policy);
+  oled_recovery.Set_Statistics_Clock(Statistics_Clock);
+  oled_recovery.Clean_Statistics();
+
+  testing::ssd1306::Inject_Nack(6+10);
+  oled_recovery.Update_Screen();
+  const SSD1306::Statistics &statistics = oled_recovery.Get_Statistics();
+  REQUIRE(statistics.transfers==4);//commands, failed data, commands, data
+  REQUIRE(statistics.data_errors==1);
+  REQUIRE(statistics.command_errors==0);
+  REQUIRE(statistics.timeouts==0);
+  REQUIRE(statistics.nacks==1);
+  REQUIRE(statistics.retries==1);
+  REQUIRE(statistics.recoveries==1);
+  REQUIRE(statistics.worst_latency_us==1000);
+  REQUIRE(statistics.frames==1);
+  REQUIRE(statistics.frame_time[1]==1);//9 clock readings
+
+  testing::ssd1306::nack_error = SSD1306::ERROR_TIMEOUT;
+  testing::ssd1306::Inject_Nack(0, 2);
+  oled_recovery.Display_On();
+  REQUIRE(statistics.command_errors==2);
+  REQUIRE(statistics.timeouts==2);
+  REQUIRE(statistics.recoveries==1);//not recovered
+  testing::ssd1306::nack_error = SSD1306::ERROR_NACK;
+  oled_recovery.Clean_Errors();
+
+  oled_recovery.Clean_Statistics();
+  for (int i = 0; i < 300; i++)
+    {
+      oled_recovery.Update_Region(0, 0, 8, 8);//5ms between first and last reading
+    }
+  REQUIRE(statistics.frames==300);
+  REQUIRE(statistics.frame_time[1]==128+44);//halved after 256 frames
+  oled_recovery.Set_Statistics_Clock(nullptr);
+  oled_recovery.Set_Retry_Policy(SSD1306::Retry_Policy());
+}
+
+static_assert(SSD1306::Transfer_Timeout_Ms(1) == 1 + 2, "command takes 68us at 400kHz");
+static_assert(SSD1306::Transfer_Timeout_Ms(1024) == 47 + 2, "frame takes 23ms at 400kHz");
+
+TEST_CASE( "timed out transfer stops update without further transfers")
+{
+  testing::ssd1306::panel.Reset();
+  oled_recovery.Initialize();
+  oled_recovery.Clean_Statistics();
+
+  testing::ssd1306::nack_error = SSD1306::ERROR_TIMEOUT;
+  testing::ssd1306::Inject_Nack(6+3);
+  oled_recovery.Update_Region(0, 0, 100, 64);//8 transfers of data if bus works
+  testing::ssd1306::nack_error = SSD1306::ERROR_NACK;
+
+  REQUIRE(oled_recovery.Get_Last_Error()==SSD1306::ERROR_TIMEOUT);
+  REQUIRE(oled_recovery.Get_Statistics().transfers==2);
+  REQUIRE(oled_recovery.Get_Statistics().timeouts==1);
+  REQUIRE(oled_recovery.Get_Statistics().nacks==0);
+  oled_recovery.Clean_Errors();
+}
@@ -0,0 +1,343 @@
+/**
+ ******************************************************************************
+ * @file    SSD1306_reference_test.cpp
+ * @author  agent
+ * @date    17.10.2026
+ * @brief   Differential tests of drawing functions against reference canvas
+ ******************************************************************************
+ * <h2><center>&copy; COPYRIGHT(c) 2026 agent
+ * </center></h2>
+ *
+ *Permission is hereby granted, free of charge,
+ *to any person obtaining a copy of this software and associated documentation files
+ *(the "Software"), to deal in the Software without restriction,
+ *including without limitation the rights to use, copy, modify,
+ *merge, publish, distribute, sublicense, and/or sell copies of
+ *the Software, and to permit persons to whom the Software is furnished to do so,
+ *subject to the following conditions:
+ *
+ *The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ *THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ *INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ *PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ *FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************************************
+ */
+
+#include <stdlib.h>
+#include <random>
+#include <string>
+#include "catch.hpp"
+#include "SSD1306.hpp"
+#include "testing.hpp"
+#include "emulator.hpp"
+#include "reference.hpp"
+
+// Differential mode: every primitive is drawn with random parameters on both SSD1306 and
+// testing::Reference_Canvas, starting from random background. Buffer and emulated panel (after
+// SSD1306::Update_Dirty) have to match reference after each call. Number of calls per primitive and
+// display height can be changed with environment variable SSD1306_DIFFERENTIAL_RUNS; seed is taken
+// from Catch --rng-seed.
+
+namespace
+{
+  void *dummy_reference;
+  SSD1306 oled_reference_64(&dummy_reference, 64);
+  SSD1306 oled_reference_32(&dummy_reference, 32);
+
+  std::mt19937 random_engine;
+
+  uint32_t Runs(void)
+  {
+    const char *runs = getenv("SSD1306_DIFFERENTIAL_RUNS");
+    return runs != nullptr ? uint32_t(atol(runs)) : 200;
+  }
+
+  uint32_t Random(uint32_t limit)
+  {
+    return std::uniform_int_distribution<uint32_t>(0, limit - 1)(random_engine);
+  }
+
+  /// Half of values are near edges of display, pages and uint8_t range
+  uint8_t Coordinate(uint8_t size)
+  {
+    const uint8_t edges[] = { 0, 1, 7, 8, 9, uint8_t(size / 2), uint8_t(size - 9), uint8_t(size - 8),
+        uint8_t(size - 1), size, uint8_t(size + 1), 254, 255 };
+    return Random(2) ? edges[Random(sizeof(edges))] : uint8_t(Random(256));
+  }
+
+  /// Lengths near 0, edges of display and uint8_t range
+  uint8_t Length(void)
+  {
+    const uint8_t edges[] = { 0, 1, 2, 7, 8, 9, 31, 32, 33, 63, 64, 65, 127, 128, 129, 255 };
+    return Random(2) ? edges[Random(sizeof(edges))] : uint8_t(Random(256));
+  }
+
+  int16_t Position(void)
+  {
+    return int16_t(Random(2) ? int(Random(2 * 140)) - 140 : int(Random(2 * 600)) - 600);
+  }
+
+  SSD1306::Color Color(void)
+  {
+    const SSD1306::Color colors[] = { SSD1306::Color::BLACK, SSD1306::Color::WHITE, SSD1306::Color::INVERT };
+    return colors[Random(3)];
+  }
+
+  Patterns::PatternDef Pattern(void)
+  {
+    const Patterns::PatternDef patterns[] = { Patterns::solid, Patterns::checker, Patterns::diagonal,
+        Patterns::dots, Patterns::gray_75 };
+    Patterns::PatternDef pattern = patterns[Random(sizeof(patterns) / sizeof(patterns[0]))];
+    if (Random(2))
+      {
+        for (uint8_t &column : pattern.Columns)
+          {
+            column = uint8_t(Random(256));
+          }
+      }
+    return pattern;
+  }
+
+  std::vector<uint8_t> Random_Image(void)
+  {
+    std::vector<uint8_t> image(1024);
+    for (uint8_t &byte : image)
+      {
+        byte = uint8_t(Random(256));
+      }
+    return image;
+  }
+
+  std::string Panel_Difference(const testing::Reference_Canvas &reference, uint8_t height)
+  {
+    const std::vector<uint8_t> expected = reference.Image();
+    for (uint8_t page = 0; page < height / 8; page++)
+      {
+        for (uint8_t column = 0; column < 128; column++)
+          {
+            if (testing::ssd1306::panel.Ram(column, page) != expected[page * 128 + column])
+              {
+                return "panel differs from reference at column " + std::to_string(column) + " page "
+                    + std::to_string(page);
+              }
+          }
+      }
+    return "";
+  }
+
+  /// Runs \a draw on display and reference for both display heights
+  template<typename Draw>
+  void Differential(Draw draw)
+  {
+    random_engine.seed(Catch::rngSeed());
+    for (uint8_t height : { 64, 32 })
+      {
+        SSD1306 &oled = height == 64 ? oled_reference_64 : oled_reference_32;
+        testing::ssd1306::panel.Reset(false, height);
+        oled.Initialize();
+        for (uint32_t run = 0; run < Runs(); run++)
+          {
+            testing::Reference_Canvas reference(height);
+            const std::vector<uint8_t> background = Random_Image();
+            oled.Draw_Image(background.data());
+            reference.Draw_Image(background.data());
+            draw(oled, reference, height);
+
+            uint8_t image[1024];
+            oled.Take_Snapshot(image);
+            oled.Update_Dirty();
+            testing::ssd1306::data.clear();
+            INFO("height " << int(height) << ", run " << run);
+            REQUIRE(reference.Compare(image) == "");
+            REQUIRE(Panel_Difference(reference, height) == "");
+          }
+      }
+  }
+}
+
+TEST_CASE( "differential: pixels and lines")
+{
+  Differential([](SSD1306 &oled, testing::Reference_Canvas &reference, uint8_t height)
+    {
+      for (int i = 0; i < 4; i++)
+        {
+          uint8_t x = Coordinate(128), y = Coordinate(height);
+          SSD1306::Color c = Color();
+          oled.Draw_Pixel(x, y, c);
+          reference.Draw_Pixel(x, y, c);
+        }
+      uint8_t x = Coordinate(128), y = Coordinate(height), length = Length();
+      SSD1306::Color c = Color();
+      oled.Draw_Line_H(x, y, length, c);
+      reference.Draw_Line_H(x, y, length, c);
+      x = Coordinate(128), y = Coordinate(height), length = Length(), c = Color();
+      oled.Draw_Line_V(x, y, length, c);
+      reference.Draw_Line_V(x, y, length, c);
+    });
+}
+
+TEST_CASE( "differential: squares and waveforms")
+{
+  Differential([](SSD1306 &oled, testing::Reference_Canvas &reference, uint8_t height)
+    {
+      uint8_t x = Coordinate(128), y = Coordinate(height), x2 = Coordinate(128), y2 = Coordinate(height);
+      SSD1306::Color c = Color();
+      oled.Draw_Square(x, y, x2, y2, c);
+      reference.Draw_Square(x, y, x2, y2, c);
+
+      uint8_t values[64];
+      const uint8_t size = uint8_t(Random(sizeof(values) + 1));
+      for (uint8_t &value : values)
+        {
+          value = Random(4) ? uint8_t(Random(height)) : uint8_t(Random(256));
+        }
+      x = Coordinate(128), y = Coordinate(height), c = Color();
+      oled.Draw_Waveform(x, y, values, size, c);
+      reference.Draw_Waveform(x, y, values, size, c);
+    });
+}
+
+TEST_CASE( "differential: rectangles, regions and fills")
+{
+  Differential([](SSD1306 &oled, testing::Reference_Canvas &reference, uint8_t height)
+    {
+      uint8_t x = Coordinate(128), y = Coordinate(height), width = Length(), h = Length();
+      switch (Random(6))
+        {
+        case 0:
+          {
+            SSD1306::Color c = Color();
+            oled.Fill_Rectangle(x, y, width, h, c);
+            reference.Fill_Rectangle(x, y, width, h, c);
+            break;
+          }
+        case 1:
+          {
+            Patterns::PatternDef pattern = Pattern();
+            oled.Fill_Rectangle(x, y, width, h, pattern);
+            reference.Fill_Rectangle(x, y, width, h, pattern);
+            break;
+          }
+        case 2:
+          oled.Invert_Region(x, y, width, h);
+          reference.Invert_Region(x, y, width, h);
+          break;
+        case 3:
+          {
+            std::vector<uint8_t> image = Random_Image();
+            oled.Draw_Image_Region(image.data(), x, y, width, h);
+            reference.Draw_Image_Region(image.data(), x, y, width, h);
+            break;
+          }
+        case 4:
+          {
+            SSD1306::Color c = Color();
+            oled.Fill(c);
+            reference.Fill(c);
+            break;
+          }
+        default:
+          {
+            uint32_t pattern = uint32_t(Random(0x10000)) << 16 | Random(0x10000);
+            oled.Fill_Pattern(pattern);
+            reference.Fill_Pattern(pattern);
+            break;
+          }
+        }
+    });
+}
+
+TEST_CASE( "differential: copy region")
+{
+  Differential([](SSD1306 &oled, testing::Reference_Canvas &reference, uint8_t height)
+    {
+      uint8_t x = Coordinate(128), y = Coordinate(height), width = Length(), h = Length();
+      int16_t to_x = Position(), to_y = Position();
+      if (Random(2))
+        {
+          // page aligned copy has its own path
+          y = uint8_t(y & ~7), h = uint8_t(h & ~7), to_y = int16_t(to_y & ~7);
+        }
+      oled.Copy_Region(x, y, width, h, to_x, to_y);
+      reference.Copy_Region(x, y, width, h, to_x, to_y);
+    });
+}
+
+TEST_CASE( "differential: circles and polygons")
+{
+  Differential([](SSD1306 &oled, testing::Reference_Canvas &reference, uint8_t height)
+    {
+      uint8_t x = Coordinate(128), y = Coordinate(height), radius = Random(2) ? uint8_t(Random(40)) : Length();
+      if (Random(2))
+        {
+          SSD1306::Color c = Color();
+          oled.Fill_Circle(x, y, radius, c);
+          reference.Fill_Circle(x, y, radius, c);
+        }
+      else
+        {
+          Patterns::PatternDef pattern = Pattern();
+          oled.Fill_Circle(x, y, radius, pattern);
+          reference.Fill_Circle(x, y, radius, pattern);
+        }
+
+      SSD1306::Point points[SSD1306_POLYGON_MAX_POINTS + 1];
+      const uint8_t count = uint8_t(Random(SSD1306_POLYGON_MAX_POINTS + 2));
+      for (uint8_t i = 0; i < count; i++)
+        {
+          points[i] = Random(4) ? SSD1306::Point { int16_t(int(Random(160)) - 16), int16_t(int(Random(96)) - 16) } :
+              SSD1306::Point { Position(), Position() };
+        }
+      if (Random(2))
+        {
+          SSD1306::Color c = Color();
+          oled.Fill_Polygon(points, count, c);
+          reference.Fill_Polygon(points, count, c);
+        }
+      else
+        {
+          Patterns::PatternDef pattern = Pattern();
+          oled.Fill_Polygon(points, count, pattern);
+          reference.Fill_Polygon(points, count, pattern);
+        }
+    });
+}
+
+TEST_CASE( "differential: text")
+{
+  Differential([](SSD1306 &oled, testing::Reference_Canvas &reference, uint8_t height)
+    {
+      const Fonts::FontDef fonts[] = { Fonts::font_7x10, Fonts::font_11x18, Fonts::font_16x26 };
+      const Fonts::FontDef &font = fonts[Random(3)];
+      uint8_t x = Coordinate(128), y = Coordinate(height);
+      oled.Set_Font_size(font);
+      reference.Set_Font_size(font);
+      oled.Set_Cursor(x, y);
+      reference.Set_Cursor(x, y);
+
+      char text[24];
+      const uint8_t length = uint8_t(Random(sizeof(text)));
+      for (uint8_t i = 0; i < length; i++)
+        {
+          text[i] = Random(4) ? char(' ' + Random(95)) : char(1 + Random(255));
+        }
+      text[length] = '\0';
+      if (Random(2))
+        {
+          oled.Write_String(text);
+          reference.Write_String(text);
+        }
+      else
+        {
+          oled.Write_String_Inverted(text);
+          reference.Write_String_Inverted(text);
+        }
+    });
+  oled_reference_64.Set_Font_size(Fonts::font_7x10);
+  oled_reference_32.Set_Font_size(Fonts::font_7x10);
+}
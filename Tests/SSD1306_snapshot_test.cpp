@@ -0,0 +1,214 @@
+/**
+ ******************************************************************************
+ * @file    SSD1306_snapshot_test.cpp
+ * @author  agent
+ * @date    17.10.2026
+ * @brief   Unit test for snapshots, deltas and run-length encoding
+ ******************************************************************************
+ * <h2><center>&copy; COPYRIGHT(c) 2026 agent
+ * </center></h2>
+ *
+ *Permission is hereby granted, free of charge,
+ *to any person obtaining a copy of this software and associated documentation files
+ *(the "Software"), to deal in the Software without restriction,
+ *including without limitation the rights to use, copy, modify,
+ *merge, publish, distribute, sublicense, and/or sell copies of
+ *the Software, and to permit persons to whom the Software is furnished to do so,
+ *subject to the following conditions:
+ *
+ *The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ *THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ *INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ *PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ *FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************************************
+ */
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "catch.hpp"
+#include "SSD1306.hpp"
+#include "SSD1306_snapshot.hpp"
+#include "testing.hpp"
+#include "emulator.hpp"
+
+namespace
+{
+  void *dummy_snapshot;
+  SSD1306 oled_snapshot(&dummy_snapshot, 64);
+
+  std::vector<uint8_t> Snapshot(void)
+  {
+    std::vector<uint8_t> image(SSD1306_Snapshot::size);
+    oled_snapshot.Take_Snapshot(image.data());
+    return image;
+  }
+}
+
+TEST_CASE( "delta contains only changed runs of pages")
+{
+  oled_snapshot.Clean();
+  const std::vector<uint8_t> before = Snapshot();
+  oled_snapshot.Draw_Pixel(10, 3, SSD1306::Color::WHITE);
+  oled_snapshot.Draw_Pixel(12, 3, SSD1306::Color::WHITE); //gap of 1 byte is included
+  oled_snapshot.Draw_Pixel(20, 3, SSD1306::Color::WHITE); //gap of 7 bytes starts new record
+  oled_snapshot.Draw_Pixel(127, 63, SSD1306::Color::WHITE);
+  const std::vector<uint8_t> after = Snapshot();
+
+  std::vector<uint8_t> delta(64);
+  uint16_t size = 0;
+  REQUIRE(SSD1306_Snapshot::Encode_Delta(before.data(), after.data(), delta.data(), uint16_t(delta.size()), size));
+  delta.resize(size);
+  REQUIRE(delta == std::vector<uint8_t>({0, 10, 3, 0x08, 0, 0x08,
+      0, 20, 1, 0x08,
+      7, 127, 1, 0x80}));
+
+  std::vector<uint8_t> copy = before;
+  REQUIRE(SSD1306_Snapshot::Apply_Delta(copy.data(), delta.data(), size));
+  REQUIRE(copy == after);
+
+  REQUIRE(SSD1306_Snapshot::Encode_Delta(after.data(), after.data(), delta.data(), 0, size));
+  REQUIRE(size == 0);
+  REQUIRE_FALSE(SSD1306_Snapshot::Encode_Delta(before.data(), after.data(), delta.data(), 13, size));
+
+  const uint8_t malformed[][4] = { { 8, 0, 1, 0 }, { 0, 127, 2, 0 }, { 0, 0, 0, 0 }, { 0, 0, 2, 0 } };
+  for (const uint8_t *record : malformed)
+    {
+      REQUIRE_FALSE(SSD1306_Snapshot::Apply_Delta(copy.data(), record, 4));
+    }
+  REQUIRE_FALSE(SSD1306_Snapshot::Apply_Delta(copy.data(), malformed[0], 2));
+}
+
+TEST_CASE( "delta of random changes reproduces snapshot")
+{
+  std::vector<uint8_t> before(SSD1306_Snapshot::size), after(SSD1306_Snapshot::size);
+  uint32_t seed = 1;
+  for (uint32_t i = 0; i < before.size(); i++)
+    {
+      seed = seed * 1103515245 + 12345;
+      before[i] = uint8_t(seed >> 16);
+      after[i] = (seed >> 28) < 3 ? uint8_t(seed >> 8) : before[i];
+    }
+  std::vector<uint8_t> delta(2048);
+  uint16_t size = 0;
+  REQUIRE(SSD1306_Snapshot::Encode_Delta(before.data(), after.data(), delta.data(), uint16_t(delta.size()), size));
+  REQUIRE(size < 1024);
+  REQUIRE(SSD1306_Snapshot::Apply_Delta(before.data(), delta.data(), size));
+  REQUIRE(before == after);
+}
+
+TEST_CASE( "run-length encoding of frames")
+{
+  std::vector<uint8_t> image(SSD1306_Snapshot::size, 0);
+  std::vector<uint8_t> encoded(2048);
+  std::vector<uint8_t> decoded(SSD1306_Snapshot::size);
+  uint16_t size = 0;
+  REQUIRE(SSD1306_Snapshot::Encode_Rle(image.data(), encoded.data(), uint16_t(encoded.size()), size));
+  REQUIRE(size == 16); //runs of at most 129 bytes
+  REQUIRE(SSD1306_Snapshot::Decode_Rle(encoded.data(), size, decoded.data()));
+  REQUIRE(decoded == image);
+
+  uint32_t seed = 7;
+  for (uint32_t i = 0; i < image.size(); i++) //random bytes with runs of various lengths
+    {
+      seed = seed * 1103515245 + 12345;
+      image[i] = (seed >> 30) ? uint8_t(i / 5) : uint8_t(seed >> 16);
+    }
+  REQUIRE(SSD1306_Snapshot::Encode_Rle(image.data(), encoded.data(), uint16_t(encoded.size()), size));
+  REQUIRE(size <= 1024 + 1024 / 128);
+  REQUIRE(SSD1306_Snapshot::Decode_Rle(encoded.data(), size, decoded.data()));
+  REQUIRE(decoded == image);
+
+  REQUIRE_FALSE(SSD1306_Snapshot::Encode_Rle(image.data(), encoded.data(), uint16_t(size - 1), size));
+  REQUIRE_FALSE(SSD1306_Snapshot::Decode_Rle(encoded.data(), 3, decoded.data())); //too short
+  const uint8_t too_long[] = { 255, 0, 255, 0, 255, 0, 255, 0, 255, 0, 255, 0, 255, 0, 255, 0, 255, 0 };
+  REQUIRE_FALSE(SSD1306_Snapshot::Decode_Rle(too_long, sizeof(too_long), decoded.data()));
+  const uint8_t truncated[] = { 5, 1, 2 };
+  REQUIRE_FALSE(SSD1306_Snapshot::Decode_Rle(truncated, sizeof(truncated), decoded.data()));
+}
+
+TEST_CASE( "snapshot is converted to PBM image")
+{
+  std::vector<uint8_t> image(SSD1306_Snapshot::size, 0);
+  image[0] = 0x01; //pixel 0,0
+  image[7 * 128 + 127] = 0x80; //pixel 127,63
+  image[128 + 9] = 0x04; //pixel 9,10
+  std::vector<uint8_t> pbm(SSD1306_Snapshot::pbm_size);
+  REQUIRE(SSD1306_Snapshot::Encode_Pbm(image.data(), pbm.data()) == pbm.size());
+  REQUIRE(std::string(pbm.begin(), pbm.begin() + 10) == "P4\n128 64\n");
+  REQUIRE(pbm[10] == 0x80);
+  REQUIRE(pbm[10 + 10 * 16 + 1] == 0x40);
+  REQUIRE(pbm.back() == 0x01);
+  REQUIRE(std::count(pbm.begin() + 10, pbm.end(), 0) == 1024 - 3);
+}
+
+TEST_CASE( "changes made from scratch are found by comparing with snapshot")
+{
+  oled_snapshot.Clean();
+  oled_snapshot.Update_Screen();
+  const std::vector<uint8_t> shown = Snapshot();
+
+  std::vector<uint8_t> image = shown;
+  image[3 * 128 + 40] = 0xFF;
+  image[3 * 128 + 45] = 0x0F;
+  oled_snapshot.Draw_Image(image.data()); //marks whole buffer as changed
+  oled_snapshot.Mark_Changes(shown.data());
+  testing::ssd1306::data.clear();
+  oled_snapshot.Update_Dirty();
+  REQUIRE(testing::ssd1306::data == std::vector<uint8_t>({0x21, 40, 45, 0x22, 3, 3, 0xFF, 0, 0, 0, 0, 0x0F}));
+
+  oled_snapshot.Mark_Changes(image.data());
+  testing::ssd1306::data.clear();
+  oled_snapshot.Update_Dirty();
+  REQUIRE(testing::ssd1306::data.empty());
+}
+
+TEST_CASE( "frame-diff update sends only differing column runs")
+{
+  testing::ssd1306::panel.Reset();
+  oled_snapshot.Initialize();
+  oled_snapshot.Clean();
+  oled_snapshot.Update_Screen();
+  std::vector<uint8_t> shadow = Snapshot();
+  oled_snapshot.Set_Shadow(shadow.data());
+
+  std::vector<uint8_t> image(SSD1306_Snapshot::size, 0);
+  image[2 * 128 + 10] = 0x01;
+  image[2 * 128 + 20] = 0x01; //gap of 9 bytes is cheaper than another window
+  image[2 * 128 + 40] = 0x01;
+  image[3 * 128 + 40] = 0x01; //merged with page above
+  image[7 * 128 + 127] = 0x80;
+  oled_snapshot.Draw_Image(image.data());
+  uint32_t sent = testing::ssd1306::panel.data_bytes;
+  oled_snapshot.Update_Changed();
+  REQUIRE(testing::ssd1306::panel.data_bytes - sent == 11 + 2 + 1);
+  REQUIRE(shadow == image);
+  for (uint8_t page = 0; page < 8; page++)
+    {
+      for (uint8_t column = 0; column < 128; column++)
+        {
+          REQUIRE(testing::ssd1306::panel.Ram(column, page) == image[page * 128 + column]);
+        }
+    }
+
+  testing::ssd1306::data.clear();
+  oled_snapshot.Draw_Image(image.data()); //the same frame again
+  oled_snapshot.Update_Changed();
+  oled_snapshot.Update_Dirty();
+  REQUIRE(testing::ssd1306::data.empty());
+
+  image[5 * 128 + 64] = 0xAA;
+  oled_snapshot.Draw_Image(image.data());
+  testing::ssd1306::Inject_Nack(6); //data of window
+  oled_snapshot.Update_Changed();
+  REQUIRE(testing::ssd1306::panel.Ram(64, 5) != 0xAA);
+  oled_snapshot.Clean_Errors();
+  oled_snapshot.Update_Changed(); //failed part is sent again
+  REQUIRE(testing::ssd1306::panel.Ram(64, 5) == 0xAA);
+  oled_snapshot.Set_Shadow(nullptr);
+}
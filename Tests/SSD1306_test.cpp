@@ -33,6 +33,7 @@
 #include "image.hpp"
 #include "SSD1306.hpp"
 #include "testing.hpp"
+#include "emulator.hpp"
 
 
 void *dummy;
@@ -231,3 +232,474 @@ TEST_CASE( "Draw Waveform")
   REQUIRE(testing::ssd1306::data[11]==0b00000001);
   REQUIRE(testing::ssd1306::data[12]==0);
 }
+
+static constexpr SSD1306::Init_Sequence init_128x32 =
+    SSD1306::Make_Init_Sequence({32, SSD1306::SEQ_NOREMAP});
+
+static_assert(init_128x32[0] == 0xAE, "sequence starts with display off");
+static_assert(init_128x32[4] == 31, "multiplex ratio is height - 1");
+static_assert(init_128x32[13] == SSD1306::SEQ_NOREMAP, "COM pins configuration");
+static_assert(init_128x32[29] == 3, "last page");
+
+TEST_CASE( "builds initialization sequence from panel configuration")
+{
+  SSD1306::Panel_Config config = {64, SSD1306::ALT_REMAP};
+  config.charge_pump = false;
+  config.precharge = 0xf1;
+  config.vcomh = 0x20;
+  config.clock = 0xf0;
+  config.contrast = 0x7f;
+  SSD1306::Init_Sequence sequence = SSD1306::Make_Init_Sequence(config);
+
+  REQUIRE(sequence[1]==0xD5);
+  REQUIRE(sequence[2]==0xf0);
+  REQUIRE(sequence[3]==0xA8);
+  REQUIRE(sequence[4]==63);
+  REQUIRE(sequence[8]==0x8D);
+  REQUIRE(sequence[9]==0x10);
+  REQUIRE(sequence[12]==0xDA);
+  REQUIRE(sequence[13]==0x32);
+  REQUIRE(sequence[15]==0x7f);
+  REQUIRE(sequence[17]==0xf1);
+  REQUIRE(sequence[19]==0x20);
+  REQUIRE(sequence[29]==7);
+}
+
+TEST_CASE( "initializes with sequence given in constructor")
+{
+  SSD1306 oled32(&dummy, init_128x32);
+  testing::ssd1306::data.clear();
+
+  REQUIRE(oled32.Initialize());
+
+  REQUIRE(testing::ssd1306::data.size()==30+1+6+512);//init sequence, display on, update screen
+  for (uint32_t i=0;i<init_128x32.size();i++)
+    {
+      REQUIRE(testing::ssd1306::data[i]==init_128x32[i]);
+    }
+  REQUIRE(testing::ssd1306::data[30]==0xAF);
+  REQUIRE(testing::ssd1306::data[36]==3);//last page of 128x32 display
+}
+
+TEST_CASE( "default initialization sequence matches height and hardware configuration")
+{
+  testing::ssd1306::data.clear();
+
+  oled64.Initialize();
+
+  SSD1306::Init_Sequence expected = SSD1306::Make_Init_Sequence({64, SSD1306::ALT_NOREMAP});
+  REQUIRE(testing::ssd1306::data.size()==30+1+1030);
+  for (uint32_t i=0;i<expected.size();i++)
+    {
+      REQUIRE(testing::ssd1306::data[i]==expected[i]);
+    }
+}
+
+TEST_CASE( "narrow regions are sent in vertical addressing mode")
+{
+  testing::ssd1306::panel.Reset();
+  oled64.Initialize();
+
+  oled64.Draw_Line_V(127, 0, 64, SSD1306::Color::WHITE);//bar at the edge
+  oled64.Draw_Pixel(126, 17, SSD1306::Color::WHITE);
+  testing::ssd1306::data.clear();
+  oled64.Update_Region(126, 0, 2, 64);
+
+  REQUIRE(testing::ssd1306::data.size()==8+2*8);//one transfer of 2 columns * 8 pages
+  REQUIRE(testing::ssd1306::data[0]==0x20);
+  REQUIRE(testing::ssd1306::data[1]==0x01);
+  REQUIRE(testing::ssd1306::data[8+2]==0x02);//column 126, page 2
+  REQUIRE(testing::ssd1306::data[8+8]==0xff);//column 127, page 0
+  REQUIRE(testing::ssd1306::panel.addressing_mode==1);
+
+  // wide region switches back to horizontal mode
+  oled64.Draw_Line_H(0, 40, 100, SSD1306::Color::WHITE);
+  testing::ssd1306::data.clear();
+  oled64.Update_Region(0, 40, 100, 1);
+  REQUIRE(testing::ssd1306::data.size()==8+100);
+  REQUIRE(testing::ssd1306::data[0]==0x20);
+  REQUIRE(testing::ssd1306::data[1]==0x00);
+  REQUIRE(testing::ssd1306::panel.addressing_mode==0);
+
+  for (uint8_t y=0;y<64;y++)
+    {
+      for (uint8_t x=0;x<128;x++)
+        {
+          bool expected = x==127 || (x==126 && y==17) || (y==40 && x<100);
+          REQUIRE(testing::ssd1306::panel.Pixel(x, y)==expected);
+        }
+    }
+
+  // full screen update uses horizontal mode without switching
+  testing::ssd1306::data.clear();
+  oled64.Update_Screen();
+  REQUIRE(testing::ssd1306::data.size()==1030);
+}
+
+TEST_CASE( "partial display mode scans and updates only active pages")
+{
+  testing::ssd1306::panel.Reset();
+  oled64.Initialize();
+  oled64.Draw_Line_H(0, 5, 128, SSD1306::Color::WHITE);
+  oled64.Update_Screen();
+
+  testing::ssd1306::data.clear();
+  REQUIRE(oled64.Enter_Partial_Mode(10, 12));//pages 1 and 2
+  REQUIRE(oled64.Is_Partial_Mode());
+  REQUIRE(testing::ssd1306::data.size()==5);
+  REQUIRE(testing::ssd1306::data[0]==0xA8);
+  REQUIRE(testing::ssd1306::data[1]==15);//16 rows
+  REQUIRE(testing::ssd1306::data[2]==0xD3);
+  REQUIRE(testing::ssd1306::data[3]==40);//64-16-8
+  REQUIRE(testing::ssd1306::data[4]==0x48);//start line 8
+  REQUIRE(oled64.Get_Frame_Period_Us()==9340/4);
+
+  oled64.Draw_Line_H(0, 12, 50, SSD1306::Color::WHITE);
+  oled64.Draw_Line_H(0, 45, 50, SSD1306::Color::WHITE);//inactive page 5
+  testing::ssd1306::data.clear();
+  oled64.Update_Screen();
+  REQUIRE(testing::ssd1306::data.size()==6+2*128);//only active pages
+  REQUIRE(testing::ssd1306::data[4]==1);
+  REQUIRE(testing::ssd1306::data[5]==2);
+
+  for (uint8_t y=0;y<64;y++)
+    {
+      for (uint8_t x=0;x<128;x++)
+        {
+          REQUIRE(testing::ssd1306::panel.Pixel(x, y)==(y==12 && x<50));//line at row 5 is not scanned
+        }
+    }
+
+  oled64.Flip_Screen(true);
+  REQUIRE(testing::ssd1306::panel.Pixel(0, 63-12));//active rows are kept in the same place
+  REQUIRE_FALSE(testing::ssd1306::panel.Pixel(0, 63-5));
+  oled64.Flip_Screen(false);
+  REQUIRE(testing::ssd1306::panel.Pixel(0, 12));
+
+  testing::ssd1306::data.clear();
+  oled64.Exit_Partial_Mode();
+  REQUIRE_FALSE(oled64.Is_Partial_Mode());
+  REQUIRE(testing::ssd1306::data.size()==5+6+128+6+5*128);//deferred pages 0 and 3-7 are sent
+  REQUIRE(testing::ssd1306::data[1]==63);
+  REQUIRE(testing::ssd1306::data[3]==0);
+  REQUIRE(testing::ssd1306::data[4]==0x40);
+  REQUIRE(testing::ssd1306::data[5+4]==0);
+  REQUIRE(testing::ssd1306::data[5+5]==0);
+  REQUIRE(testing::ssd1306::data[5+6+128+4]==3);
+  REQUIRE(testing::ssd1306::data[5+6+128+5]==7);
+
+  for (uint8_t y=0;y<64;y++)
+    {
+      for (uint8_t x=0;x<128;x++)
+        {
+          bool expected = y==5 || ((y==12 || y==45) && x<50);
+          REQUIRE(testing::ssd1306::panel.Pixel(x, y)==expected);
+        }
+    }
+}
+
+TEST_CASE( "partial display mode covers at least 16 rows")
+{
+  SSD1306 oled32(&dummy, 32, SSD1306::SEQ_NOREMAP);
+  testing::ssd1306::panel.Reset(false, 32);
+  oled32.Initialize();
+  testing::ssd1306::data.clear();
+  REQUIRE(oled32.Enter_Partial_Mode(30, 1));//last page, extended up
+  REQUIRE(testing::ssd1306::data[1]==15);
+  REQUIRE(testing::ssd1306::data[3]==0);//32-16-16
+  REQUIRE(testing::ssd1306::data[4]==0x50);
+  REQUIRE_FALSE(oled32.Enter_Partial_Mode(32, 1));
+
+  oled32.Draw_Pixel(3, 17, SSD1306::Color::WHITE);
+  oled32.Update_Screen();
+  REQUIRE(testing::ssd1306::panel.Pixel(3, 17));
+  testing::ssd1306::data.clear();
+  oled32.Exit_Partial_Mode();
+  REQUIRE(testing::ssd1306::data.size()==5+6+2*128);//deferred pages 0 and 1
+}
+
+TEST_CASE( "exit from partial mode sends content drawn before entering it")
+{
+  testing::ssd1306::panel.Reset();
+  oled64.Initialize();
+  oled64.Clean();
+  oled64.Update_Screen();
+  oled64.Draw_Pixel(10, 45, SSD1306::Color::WHITE);//not sent before entering partial mode
+  REQUIRE(oled64.Enter_Partial_Mode(0, 16));
+  oled64.Update_Screen();
+  REQUIRE(testing::ssd1306::panel.Ram(10, 5)==0x00);
+  oled64.Exit_Partial_Mode();
+  REQUIRE(testing::ssd1306::panel.Ram(10, 5)==0x20);
+  REQUIRE(testing::ssd1306::panel.Pixel(10, 45));
+  oled64.Clean();
+}
+
+TEST_CASE( "display offset follows datasheet mapping")
+{
+  //datasheet 10.1.15: with normal scan (0xC0) COM c shows row c+offset
+  testing::ssd1306::panel.Reset();
+  testing::ssd1306::panel.Command(0xD3);
+  testing::ssd1306::panel.Command(16);
+  testing::ssd1306::panel.Command(0xB2);//page 2, row 16 is bit 0
+  testing::ssd1306::panel.Command(0x00);
+  testing::ssd1306::panel.Command(0x10);
+  testing::ssd1306::panel.Data(0x01);
+  REQUIRE(testing::ssd1306::panel.Pixel(0, 63));//COM0 is the bottom line
+  REQUIRE_FALSE(testing::ssd1306::panel.Pixel(0, 63-16));
+
+  //rows 16..31 stay on COM16..31: COM16 shows row 0 of start line 16, so offset is 64-16
+  testing::ssd1306::panel.Reset();
+  oled64.Initialize();
+  oled64.Flip_Screen(true);
+  testing::ssd1306::data.clear();
+  REQUIRE(oled64.Enter_Partial_Mode(16, 16));
+  REQUIRE(testing::ssd1306::data[3]==48);
+  REQUIRE(testing::ssd1306::data[4]==0x50);
+  oled64.Flip_Screen(false);
+  testing::ssd1306::data.clear();
+  REQUIRE(oled64.Enter_Partial_Mode(16, 16));
+  REQUIRE(testing::ssd1306::data[3]==32);//COM[15] is top row 16 with remapped scan: 64-16-16
+  oled64.Exit_Partial_Mode();
+}
+
+static bool Power_Probe(void *context)
+{
+  return *static_cast<bool*>(context);
+}
+
+TEST_CASE( "resume from sleep keeps display memory")
+{
+  testing::ssd1306::panel.Reset();
+  oled64.Initialize();
+  oled64.Draw_Line_V(64, 0, 64, SSD1306::Color::WHITE);
+  oled64.Update_Screen();
+
+  testing::ssd1306::data.clear();
+  oled64.Sleep();
+  REQUIRE_FALSE(testing::ssd1306::panel.display_on);
+  REQUIRE(oled64.Resume()==SSD1306::RESUMED);
+  REQUIRE(testing::ssd1306::data == std::vector<uint8_t>({0xAE, 0xAF}));//one command each, no frame data
+  REQUIRE(testing::ssd1306::panel.display_on);
+  REQUIRE(testing::ssd1306::panel.Pixel(64, 30));
+
+  bool powered = false;//display lost power while sleeping
+  oled64.Set_Power_Probe(Power_Probe, &powered);
+  oled64.Sleep();
+  testing::ssd1306::panel.Reset();
+  testing::ssd1306::data.clear();
+  REQUIRE(oled64.Resume()==SSD1306::REINITIALIZED);
+  REQUIRE(testing::ssd1306::data.size()==30+1+1030);//configuration, display on and whole buffer
+  REQUIRE(testing::ssd1306::panel.display_on);
+  for (uint8_t y=0;y<64;y++)
+    {
+      for (uint8_t x=0;x<128;x++)
+        {
+          REQUIRE(testing::ssd1306::panel.Pixel(x, y)==(x==64));//buffer is not cleaned
+        }
+    }
+
+  powered = true;
+  oled64.Sleep();
+  testing::ssd1306::data.clear();
+  REQUIRE(oled64.Resume()==SSD1306::RESUMED);
+  REQUIRE(testing::ssd1306::data.size()==1);
+  oled64.Set_Power_Probe(nullptr, nullptr);
+}
+
+namespace
+{
+  bool Pattern_Pixel(const Patterns::PatternDef &pattern, uint8_t x, uint8_t y)
+  {
+    return (pattern.Columns[x % 8] >> (y % 8)) & 1;
+  }
+
+  void Require_Panel_Shows(bool (*expected)(uint8_t x, uint8_t y))
+  {
+    for (uint8_t y = 0; y < 64; y++)
+      {
+        for (uint8_t x = 0; x < 128; x++)
+          {
+            REQUIRE(testing::ssd1306::panel.Pixel(x, y) == expected(x, y));
+          }
+      }
+  }
+}
+
+TEST_CASE( "fills rectangle with pattern")
+{
+  testing::ssd1306::panel.Reset();
+  oled64.Initialize();
+  oled64.Fill_Rectangle(3, 5, 20, 13, Patterns::diagonal);
+  oled64.Fill_Rectangle(120, 60, 50, 50, SSD1306::Color::WHITE); //clipped
+  oled64.Update_Dirty();
+  Require_Panel_Shows([](uint8_t x, uint8_t y)
+    {
+      if (x >= 120 && y >= 60)
+        {
+          return true;
+        }
+      return x >= 3 && x < 23 && y >= 5 && y < 18 && Pattern_Pixel(Patterns::diagonal, x, y);
+    });
+
+  oled64.Fill_Rectangle(0, 0, 128, 64, Patterns::gray_25);
+  oled64.Fill_Rectangle(8, 9, 10, 10, SSD1306::Color::BLACK);
+  oled64.Update_Dirty();
+  Require_Panel_Shows([](uint8_t x, uint8_t y)
+    {
+      return !(x >= 8 && x < 18 && y >= 9 && y < 19) && Pattern_Pixel(Patterns::gray_25, x, y);
+    });
+}
+
+TEST_CASE( "fills circle")
+{
+  testing::ssd1306::panel.Reset();
+  oled64.Initialize();
+  oled64.Fill_Circle(64, 32, 10, SSD1306::Color::WHITE);
+  oled64.Fill_Circle(2, 2, 5, Patterns::checker); //clipped
+  oled64.Update_Dirty();
+  Require_Panel_Shows([](uint8_t x, uint8_t y)
+    {
+      int dx = x - 64, dy = y - 32;
+      int cx = x - 2, cy = y - 2;
+      return dx * dx + dy * dy <= 100 || (cx * cx + cy * cy <= 25 && Pattern_Pixel(Patterns::checker, x, y));
+    });
+}
+
+TEST_CASE( "fills polygon")
+{
+  testing::ssd1306::panel.Reset();
+  oled64.Initialize();
+  const SSD1306::Point triangle[] = { { 10, 10 }, { 30, 10 }, { 10, 30 } };
+  const SSD1306::Point outside[] = { { -20, 40 }, { 5, 40 }, { 5, 100 }, { -20, 100 } };
+  const SSD1306::Point concave[] = { { 60, 0 }, { 90, 0 }, { 90, 20 }, { 80, 20 }, { 80, 10 },
+      { 70, 10 }, { 70, 20 }, { 60, 20 } };
+  oled64.Fill_Polygon(triangle, 3, Patterns::gray_50);
+  oled64.Fill_Polygon(outside, 4, SSD1306::Color::WHITE);
+  oled64.Fill_Polygon(concave, 8, SSD1306::Color::WHITE);
+  oled64.Fill_Polygon(triangle, 2, SSD1306::Color::WHITE); //not a polygon
+  oled64.Update_Dirty();
+  Require_Panel_Shows([](uint8_t x, uint8_t y)
+    {
+      if (x >= 10 && y >= 10 && x + y <= 38)
+        {
+          return Pattern_Pixel(Patterns::gray_50, x, y);
+        }
+      bool arch = x >= 60 && x < 90 && y < 20 && !(x >= 70 && x < 80 && y >= 10);
+      return (x < 5 && y >= 40) || arch;
+    });
+}
+
+TEST_CASE( "INVERT color toggles pixels")
+{
+  testing::ssd1306::panel.Reset();
+  oled64.Initialize();
+  oled64.Fill_Rectangle(0, 0, 64, 64, SSD1306::Color::WHITE);
+  oled64.Draw_Pixel(1, 1, SSD1306::Color::INVERT);
+  oled64.Draw_Pixel(100, 1, SSD1306::Color::INVERT);
+  oled64.Draw_Square(50, 10, 80, 20, SSD1306::Color::INVERT);
+  oled64.Fill_Circle(30, 40, 5, SSD1306::Color::INVERT);
+  oled64.Update_Dirty();
+  Require_Panel_Shows([](uint8_t x, uint8_t y)
+    {
+      bool on = x < 64;
+      bool outline = x >= 50 && x <= 80 && y >= 10 && y <= 20 && (x == 50 || x == 80 || y == 10 || y == 20);
+      int dx = x - 30, dy = y - 40;
+      bool circle = dx * dx + dy * dy <= 25;
+      bool pixel = (x == 1 || x == 100) && y == 1;
+      return on != (outline || circle || pixel);
+    });
+
+  // drawing the same shapes again restores display
+  oled64.Draw_Pixel(1, 1, SSD1306::Color::INVERT);
+  oled64.Draw_Pixel(100, 1, SSD1306::Color::INVERT);
+  oled64.Draw_Square(50, 10, 80, 20, SSD1306::Color::INVERT);
+  oled64.Fill_Circle(30, 40, 5, SSD1306::Color::INVERT);
+  const SSD1306::Point triangle[] = { { 10, 10 }, { 30, 10 }, { 10, 30 } };
+  oled64.Fill_Polygon(triangle, 3, SSD1306::Color::INVERT);
+  oled64.Fill_Polygon(triangle, 3, SSD1306::Color::INVERT);
+  oled64.Fill(SSD1306::Color::INVERT);
+  oled64.Fill_Rectangle(0, 0, 128, 64, SSD1306::Color::INVERT);
+  oled64.Update_Dirty();
+  Require_Panel_Shows([](uint8_t x, uint8_t y)
+    {
+      (void) y;
+      return x < 64;
+    });
+}
+
+TEST_CASE( "moving highlight sends only changed rows")
+{
+  testing::ssd1306::panel.Reset();
+  oled64.Initialize();
+  oled64.Set_Font_size(Fonts::font_7x10);
+  const char *items[] = { "First", "Second", "Third" };
+  for (uint8_t i = 0; i < 3; i++)
+    {
+      oled64.Set_Cursor(0, uint8_t(i * 16));
+      oled64.Write_String(items[i]);
+    }
+  oled64.Invert_Region(0, 0, 128, 16);
+  oled64.Update_Dirty();
+
+  testing::ssd1306::data.clear();
+  oled64.Invert_Region(0, 0, 128, 16); //selection moves from first to second item
+  oled64.Invert_Region(0, 16, 128, 16);
+  oled64.Update_Dirty();
+  REQUIRE(testing::ssd1306::data.size() == 6 + 4 * 128);//pages 0-3 in one window
+  REQUIRE(testing::ssd1306::panel.Pixel(127, 15) == false);
+  REQUIRE(testing::ssd1306::panel.Pixel(127, 16) == true);
+  REQUIRE(testing::ssd1306::panel.Pixel(127, 31) == true);
+  REQUIRE(testing::ssd1306::panel.Pixel(127, 32) == false);
+}
+
+TEST_CASE( "shapes crossing edges are clipped instead of wrapping around")
+{
+  testing::ssd1306::panel.Reset();
+  oled64.Initialize();
+  oled64.Draw_Line_H(120, 0, 20, SSD1306::Color::WHITE);
+  oled64.Draw_Line_V(0, 60, 10, SSD1306::Color::WHITE);
+  oled64.Draw_Square(40, 20, 30, 10, SSD1306::Color::WHITE); //corners in reversed order
+  oled64.Draw_Square(100, 40, 255, 70, SSD1306::Color::WHITE);
+  uint8_t waveform[] = { 0, 0, 0, 0 };
+  oled64.Draw_Waveform(254, 3, waveform, 4, SSD1306::Color::WHITE);
+  uint8_t peaks[] = { 0, 9, 0 };
+  oled64.Draw_Waveform(60, 5, peaks, 3, SSD1306::Color::WHITE); //point above top edge is skipped
+  oled64.Update_Dirty();
+  Require_Panel_Shows([](uint8_t x, uint8_t y)
+    {
+      bool line_h = y == 0 && x >= 120;
+      bool line_v = x == 0 && y >= 60;
+      bool square = x >= 30 && x <= 40 && y >= 10 && y <= 20 && (x == 30 || x == 40 || y == 10 || y == 20);
+      bool clipped = (y == 40 && x >= 100) || (x == 100 && y >= 40);
+      bool peaks = y == 5 && (x == 60 || x == 62);
+      return line_h || line_v || square || clipped || peaks;
+    });
+}
+
+TEST_CASE( "text is clipped at right edge and unknown characters are shown as question mark")
+{
+  uint8_t expected[1024];
+  uint8_t image[1024];
+  oled64.Set_Font_size(Fonts::font_7x10);
+  oled64.Clean();
+  oled64.Set_Cursor(0, 0);
+  oled64.Write_String("a???b");
+  oled64.Take_Snapshot(expected);
+
+  oled64.Clean();
+  oled64.Set_Cursor(0, 0);
+  oled64.Write_String("a\x01\n\xe9""b"); //control characters and negative char
+  oled64.Take_Snapshot(image);
+  REQUIRE(std::vector<uint8_t>(image, image + 1024) == std::vector<uint8_t>(expected, expected + 1024));
+
+  oled64.Clean();
+  oled64.Set_Cursor(120, 0);
+  oled64.Write_String("WWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWWW"); //cursor would pass 255
+  oled64.Take_Snapshot(image);
+  for (uint8_t x = 0; x < 120; x++)
+    {
+      REQUIRE(image[x] == 0);
+      REQUIRE(image[128 + x] == 0);
+    }
+  oled64.Set_Cursor(0, 0);
+}
@@ -0,0 +1,186 @@
+/**
+ ******************************************************************************
+ * @file    SSD1306_trace_test.cpp
+ * @author  agent
+ * @date    18.10.2026
+ * @brief   Unit test for recording and decoding of command stream
+ ******************************************************************************
+ * <h2><center>&copy; COPYRIGHT(c) 2026 agent
+ * </center></h2>
+ *
+ *Permission is hereby granted, free of charge,
+ *to any person obtaining a copy of this software and associated documentation files
+ *(the "Software"), to deal in the Software without restriction,
+ *including without limitation the rights to use, copy, modify,
+ *merge, publish, distribute, sublicense, and/or sell copies of
+ *the Software, and to permit persons to whom the Software is furnished to do so,
+ *subject to the following conditions:
+ *
+ *The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ *THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ *INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ *PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ *FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************************************
+ */
+
+#include <string>
+#include <tuple>
+#include "catch.hpp"
+#include "SSD1306.hpp"
+#include "SSD1306_trace.hpp"
+#include "testing.hpp"
+
+namespace
+{
+  void *dummy_trace;
+  SSD1306 oled_trace(&dummy_trace, 64);
+
+  uint32_t time_us = 0;
+
+  uint32_t Fake_Time(void)
+  {
+    time_us += 100;
+    return time_us;
+  }
+
+  void Append(void *context, const char *line)
+  {
+    *static_cast<std::string*>(context) += line;
+  }
+
+  std::string Print(const SSD1306_Trace &trace)
+  {
+    std::string text;
+    trace.Print(Append, &text);
+    return text;
+  }
+
+  std::string Decode(const uint8_t *bytes, uint16_t size)
+  {
+    SSD1306_Trace::Command_Decoder decoder;
+    std::string text;
+    for (uint16_t i = 0; i < size; i++)
+      {
+        if (decoder.Feed(bytes[i]))
+          {
+            text += std::string(decoder.Text()) + "\n";
+          }
+      }
+    return text;
+  }
+}
+
+TEST_CASE( "decodes commands with arguments")
+{
+  const uint8_t window[] = { 0x21, 0, 127, 0x22, 0, 7 };
+  REQUIRE(Decode(window, sizeof(window)) == "SET_COLUMN 0..127\nSET_PAGE 0..7\n");
+
+  const uint8_t scroll[] = { 0x2E, 0x26, 0x00, 2, 7, 5, 0x00, 0xFF, 0x2F };
+  REQUIRE(Decode(scroll, sizeof(scroll)) == "SCROLL_OFF\nSCROLL_RIGHT pages 2..5 interval 7\nSCROLL_ON\n");
+
+  const uint8_t page_mode[] = { 0xB3, 0x02, 0x10, 0x40, 0xE3 };
+  REQUIRE(Decode(page_mode, sizeof(page_mode)) == "SET_PAGE_START 3\nSET_LOW_COLUMN 2\nSET_HIGH_COLUMN 0\n"
+      "START_LINE 0\nNOP\n");
+
+  constexpr SSD1306::Init_Sequence init = SSD1306::Make_Init_Sequence({ 32, SSD1306::SEQ_NOREMAP });
+  const std::string text = Decode(init.data(), uint16_t(init.size()));
+  CHECK(text.find("DISPLAY_OFF\nCLOCK divide 1 oscillator 8\nMULTIPLEX 32 rows\n") == 0);
+  CHECK(text.find("COM_PINS 0x02\n") != std::string::npos);
+  CHECK(text.find("ADDRESSING HORIZONTAL\n") != std::string::npos);
+  CHECK(text.find("UNKNOWN") == std::string::npos);
+
+  // command split between transfers, as sent by SSD1306::Set_Brightness
+  SSD1306_Trace::Command_Decoder decoder;
+  REQUIRE_FALSE(decoder.Feed(0x81));
+  REQUIRE(decoder.Is_Pending());
+  REQUIRE(decoder.Feed(200));
+  REQUIRE(std::string(decoder.Text()) == "CONTRAST 200");
+  REQUIRE_FALSE(decoder.Is_Pending());
+}
+
+TEST_CASE( "trace prints transfers with frame totals")
+{
+  oled_trace.Initialize();
+  testing::ssd1306::data.clear();
+  time_us = 0;
+  SSD1306_Trace trace(oled_trace, Fake_Time);
+
+  oled_trace.Update_Screen();
+  oled_trace.Set_Brightness(10);
+  oled_trace.Update_Region(0, 8, 16, 16);
+  REQUIRE(Print(trace) ==
+      "       100 us  SET_COLUMN 0..127\n"
+      "       100 us  SET_PAGE 0..7\n"
+      "       200 us  DATA 1024 bytes\n"
+      "              FRAME 1: 2 transfers, 6 command bytes, 1024 data bytes, 0 errors, 200 us\n"
+      "       500 us  CONTRAST 10\n" // command and its argument are sent separately
+      "       600 us  ADDRESSING VERTICAL\n" // narrow region
+      "       600 us  SET_COLUMN 0..15\n"
+      "       600 us  SET_PAGE 1..2\n"
+      "       700 us  DATA 32 bytes\n"
+      "              FRAME 2: 4 transfers, 10 command bytes, 32 data bytes, 0 errors, 400 us\n"
+      "TOTAL: 2 frames, 6 transfers, 16 command bytes, 1056 data bytes, 0 errors\n");
+
+  trace.Clear();
+  REQUIRE(trace.Size() == 0);
+  trace.Pause(true);
+  oled_trace.Update_Screen();
+  REQUIRE(trace.Size() == 0);
+  trace.Pause(false);
+  oled_trace.Update_Screen();
+  REQUIRE(trace.Size() == 3);
+  REQUIRE(trace.Get(0).type == SSD1306_Trace::COMMANDS);
+  REQUIRE(trace.Get(0).size == 6);
+  REQUIRE(trace.Get(0).count == 6);
+  REQUIRE(trace.Get(0).bytes[0] == 0x21);
+  REQUIRE(trace.Get(1).type == SSD1306_Trace::DATA);
+  REQUIRE(trace.Get(1).size == 1024);
+  REQUIRE(trace.Get(2).type == SSD1306_Trace::WINDOW);
+}
+
+TEST_CASE( "trace marks failed transfers")
+{
+  oled_trace.Initialize();
+  SSD1306_Trace trace(oled_trace);
+
+  testing::ssd1306::Inject_Nack(6);
+  oled_trace.Update_Screen();
+  const std::string text = Print(trace);
+  CHECK(text.find("DATA 1024 bytes (FAILED)\n") != std::string::npos);
+  CHECK(text.find("FRAME 1 FAILED: 2 transfers, 6 command bytes, 1024 data bytes, 1 errors") != std::string::npos);
+  REQUIRE((trace.Get(2).type & SSD1306_Trace::failed) != 0);
+
+  oled_trace.Clean_Errors();
+}
+
+TEST_CASE( "trace keeps newest entries in ring buffer")
+{
+  oled_trace.Initialize();
+  SSD1306_Trace trace(oled_trace);
+  for (int i = 0; i < SSD1306_TRACE_ENTRIES; i++)
+    {
+      oled_trace.Update_Region(0, 0, 1, 1);
+    }
+  REQUIRE(trace.Size() == SSD1306_TRACE_ENTRIES);
+  REQUIRE(trace.Get_Dropped() == 2 * SSD1306_TRACE_ENTRIES);
+
+  // initialization sequence takes several entries, first of them is dropped
+  const int init_entries = (SSD1306::Init_Sequence::size() + SSD1306_TRACE_BYTES - 1)
+      / SSD1306_TRACE_BYTES;
+  oled_trace.Initialize(); // sequence, DISPLAY_ON and update of screen
+  for (int i = 0; i < SSD1306_TRACE_ENTRIES - (init_entries - 1) - 1 - 3; i++)
+    {
+      oled_trace.Display_On();
+    }
+  REQUIRE(trace.Get(0).type == (SSD1306_Trace::COMMANDS | SSD1306_Trace::continued));
+  const std::string text = Print(trace);
+  CHECK(text.find("(") == 0);
+  CHECK(text.find("older entries dropped)\n") != std::string::npos);
+  CHECK(text.find("DISPLAY_ON\n") != std::string::npos);
+  CHECK(text.find("UNKNOWN") == std::string::npos);
+}
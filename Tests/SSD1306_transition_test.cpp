@@ -0,0 +1,200 @@
+/**
+ ******************************************************************************
+ * @file    SSD1306_transition_test.cpp
+ * @author  agent
+ * @date    17.10.2026
+ * @brief   Unit test for screen transitions
+ ******************************************************************************
+ * <h2><center>&copy; COPYRIGHT(c) 2026 agent
+ * </center></h2>
+ *
+ *Permission is hereby granted, free of charge,
+ *to any person obtaining a copy of this software and associated documentation files
+ *(the "Software"), to deal in the Software without restriction,
+ *including without limitation the rights to use, copy, modify,
+ *merge, publish, distribute, sublicense, and/or sell copies of
+ *the Software, and to permit persons to whom the Software is furnished to do so,
+ *subject to the following conditions:
+ *
+ *The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ *THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ *INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ *PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ *FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************************************
+ */
+
+#include <vector>
+#include "catch.hpp"
+#include "SSD1306.hpp"
+#include "SSD1306_transition.hpp"
+#include "testing.hpp"
+#include "emulator.hpp"
+
+namespace
+{
+  void *dummy_transition;
+  SSD1306 oled_transition(&dummy_transition, 64);
+
+  std::vector<uint8_t> Image(uint8_t seed)
+  {
+    std::vector<uint8_t> image(1024);
+    for (uint32_t i = 0; i < image.size(); i++)
+      {
+        image[i] = uint8_t(i * seed + (i >> 4));
+      }
+    return image;
+  }
+
+  bool Image_Pixel(const std::vector<uint8_t> &image, int x, int y)
+  {
+    return (image[x + 128 * (y / 8)] >> (y % 8)) & 1;
+  }
+
+  void Require_Panel_Shows(const std::vector<uint8_t> &image, uint8_t rows = 64)
+  {
+    for (uint8_t y = 0; y < rows; y++)
+      {
+        for (uint8_t x = 0; x < 128; x++)
+          {
+            REQUIRE(testing::ssd1306::panel.Pixel(x, y) == Image_Pixel(image, x, y));
+          }
+      }
+  }
+
+  void Show(SSD1306 &oled, const std::vector<uint8_t> &image)
+  {
+    oled.Draw_Image(image.data());
+    oled.Update_Screen();
+  }
+}
+
+TEST_CASE( "slide moves current screen with start line and sends one page per step")
+{
+  const std::vector<uint8_t> current = Image(7);
+  const std::vector<uint8_t> next = Image(13);
+  testing::ssd1306::panel.Reset();
+  oled_transition.Initialize();
+  Show(oled_transition, current);
+
+  SSD1306_Transition transition(oled_transition);
+  REQUIRE(transition.Start(next.data(), SSD1306_Transition::SLIDE_UP, 3)); //steps are always pages
+  for (uint8_t step = 1; step <= 8; step++)
+    {
+      testing::ssd1306::data.clear();
+      REQUIRE(transition.Step() == (step < 8));
+      REQUIRE(testing::ssd1306::data.size() == 6 + 128 + 1); //page window, data and start line
+      REQUIRE(testing::ssd1306::panel.start_line == (step * 8) % 64);
+      for (uint8_t y = 0; y < 64; y++)
+        {
+          for (uint8_t x = 0; x < 128; x++)
+            {
+              bool expected = (y < 64 - step * 8) ? Image_Pixel(current, x, y + step * 8) :
+                  Image_Pixel(next, x, y - (64 - step * 8));
+              REQUIRE(testing::ssd1306::panel.Pixel(x, y) == expected);
+            }
+        }
+    }
+  REQUIRE_FALSE(transition.Is_Running());
+  REQUIRE(oled_transition.Is_Equal(next.data()));
+
+  REQUIRE(transition.Start(current.data(), SSD1306_Transition::SLIDE_DOWN));
+  for (uint8_t step = 1; step <= 3; step++)
+    {
+      transition.Step();
+    }
+  for (uint8_t y = 0; y < 64; y++)
+    {
+      for (uint8_t x = 0; x < 128; x++)
+        {
+          bool expected = (y < 24) ? Image_Pixel(current, x, y + 40) : Image_Pixel(next, x, y - 24);
+          REQUIRE(testing::ssd1306::panel.Pixel(x, y) == expected);
+        }
+    }
+  transition.Finish();
+  REQUIRE(testing::ssd1306::panel.start_line == 0);
+  Require_Panel_Shows(current);
+}
+
+TEST_CASE( "wipes and dissolve send only revealed parts")
+{
+  const std::vector<uint8_t> current = Image(7);
+  const std::vector<uint8_t> next = Image(13);
+  const SSD1306_Transition::Effect effects[] = { SSD1306_Transition::WIPE_LEFT,
+      SSD1306_Transition::WIPE_RIGHT, SSD1306_Transition::WIPE_UP, SSD1306_Transition::WIPE_DOWN,
+      SSD1306_Transition::DISSOLVE };
+  for (SSD1306_Transition::Effect effect : effects)
+    {
+      testing::ssd1306::panel.Reset();
+      oled_transition.Initialize();
+      Show(oled_transition, current);
+      SSD1306_Transition transition(oled_transition);
+      REQUIRE(transition.Start(next.data(), effect, 10));
+
+      uint32_t data_bytes = testing::ssd1306::panel.data_bytes;
+      uint8_t steps = 1;
+      while (transition.Step())
+        {
+          steps++;
+          uint32_t revealed = 0;
+          for (uint8_t y = 0; y < 64; y++)
+            {
+              for (uint8_t x = 0; x < 128; x++)
+                {
+                  bool pixel = testing::ssd1306::panel.Pixel(x, y);
+                  REQUIRE((pixel == Image_Pixel(current, x, y) || pixel == Image_Pixel(next, x, y)));
+                  revealed += (Image_Pixel(current, x, y) != Image_Pixel(next, x, y)) &&
+                      pixel == Image_Pixel(next, x, y);
+                }
+            }
+          REQUIRE(revealed > 0);
+        }
+      REQUIRE(steps == 10);
+      Require_Panel_Shows(next);
+      //vertical wipes resend pages shared by two steps
+      REQUIRE(testing::ssd1306::panel.data_bytes - data_bytes <= 1024 + 128 * 9);
+    }
+}
+
+TEST_CASE( "transition is refused in partial mode and slides become wipes on 32 row display")
+{
+  const std::vector<uint8_t> next = Image(13);
+  testing::ssd1306::panel.Reset();
+  oled_transition.Initialize();
+  SSD1306_Transition transition(oled_transition);
+  oled_transition.Enter_Partial_Mode(0, 16);
+  REQUIRE_FALSE(transition.Start(next.data(), SSD1306_Transition::WIPE_LEFT));
+  REQUIRE_FALSE(oled_transition.Set_Start_Line(8));
+  oled_transition.Exit_Partial_Mode();
+  REQUIRE_FALSE(transition.Start(nullptr, SSD1306_Transition::WIPE_LEFT));
+  REQUIRE_FALSE(transition.Step());
+
+  SSD1306 oled32(&dummy_transition, 32, SSD1306::SEQ_NOREMAP);
+  testing::ssd1306::panel.Reset(false, 32);
+  oled32.Initialize();
+  SSD1306_Transition transition32(oled32);
+  REQUIRE(transition32.Start(next.data(), SSD1306_Transition::SLIDE_UP, 4));
+  transition32.Step();
+  REQUIRE(testing::ssd1306::panel.start_line == 0);
+  transition32.Finish();
+  Require_Panel_Shows(next, 32);
+}
+
+TEST_CASE( "dissolve reveals every block of 56 row display")
+{
+  const std::vector<uint8_t> next = Image(13);
+  void *dummy;
+  SSD1306 oled56(&dummy, 56);
+  oled56.Initialize();
+  oled56.Clean();
+  SSD1306_Transition transition(oled56);
+  REQUIRE(transition.Start(next.data(), SSD1306_Transition::DISSOLVE, 10));
+  transition.Finish();
+  std::vector<uint8_t> expected(next.begin(), next.begin() + 7 * 128);
+  expected.resize(1024);
+  REQUIRE(oled56.Is_Equal(expected.data()));
+}
@@ -0,0 +1,68 @@
+/**
+ ******************************************************************************
+ * @file    alloc_check/SSD1306_hardware.cpp
+ * @author  agent
+ * @date    17.10.2026
+ * @brief   Fake hardware related functions for allocation checker. Does not use heap.
+ ******************************************************************************
+ * <h2><center>&copy; COPYRIGHT(c) 2026 agent
+ * </center></h2>
+ *
+ *Permission is hereby granted, free of charge,
+ *to any person obtaining a copy of this software and associated documentation files
+ *(the "Software"), to deal in the Software without restriction,
+ *including without limitation the rights to use, copy, modify,
+ *merge, publish, distribute, sublicense, and/or sell copies of
+ *the Software, and to permit persons to whom the Software is furnished to do so,
+ *subject to the following conditions:
+ *
+ *The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ *THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ *INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ *PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ *FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************************************
+ */
+
+#include "SSD1306.hpp"
+#include "alloc_check.hpp"
+
+namespace alloc_check
+{
+  uint32_t command_bytes = 0;
+  uint32_t data_bytes = 0;
+  uint32_t transfers_pending = 0;
+}
+
+bool SSD1306::Transmit (uint8_t control_byte, const uint8_t *data, uint16_t size)
+{
+  (void) data;
+  if (control_byte == control_b_command)
+    {
+      alloc_check::command_bytes += size;
+    }
+  else
+    {
+      alloc_check::data_bytes += size;
+    }
+  return true;
+}
+
+bool SSD1306::Start_Transfer (uint8_t control_byte, const uint8_t *data, uint16_t size)
+{
+  (void) data;
+  if (control_byte == control_b_command)
+    {
+      alloc_check::command_bytes += size;
+    }
+  else
+    {
+      alloc_check::data_bytes += size;
+    }
+  alloc_check::transfers_pending++;
+  return true;
+}
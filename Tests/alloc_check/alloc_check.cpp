@@ -0,0 +1,481 @@
+/**
+ ******************************************************************************
+ * @file    alloc_check/alloc_check.cpp
+ * @author  agent
+ * @date    17.10.2026
+ * @brief   Checks that library never uses heap
+ ******************************************************************************
+ * <h2><center>&copy; COPYRIGHT(c) 2026 agent
+ * </center></h2>
+ *
+ *Permission is hereby granted, free of charge,
+ *to any person obtaining a copy of this software and associated documentation files
+ *(the "Software"), to deal in the Software without restriction,
+ *including without limitation the rights to use, copy, modify,
+ *merge, publish, distribute, sublicense, and/or sell copies of
+ *the Software, and to permit persons to whom the Software is furnished to do so,
+ *subject to the following conditions:
+ *
+ *The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ *THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ *INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ *PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ *FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************************************
+ *
+ * Every global allocation function is replaced with one which aborts while checks are running,
+ * then all drawing primitives and update paths are executed. Library is compiled without
+ * exceptions, so use of them fails at compile time. Build and run on host (from repository root):
+ *
+ *   g++ -std=c++20 -fno-exceptions -fno-rtti -ITests/alloc_check -ITests/fakes -IInc \
+ *       Src/SSD1306.cpp Src/SSD1306_async.cpp Src/SSD1306_pacer.cpp Src/SSD1306_list.cpp \
+ *       Src/SSD1306_transition.cpp Src/SSD1306_animation.cpp Src/SSD1306_snapshot.cpp \
+ *       Src/SSD1306_mirror.cpp Src/SSD1306_mirror_decoder.cpp Src/SSD1306_trace.cpp \
+ *       Tests/alloc_check/alloc_check.cpp Tests/alloc_check/SSD1306_hardware.cpp -o alloc_check && ./alloc_check
+ *
+ * Non-zero exit code (abort) means that something allocated.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <new>
+#include "SSD1306.hpp"
+#include "SSD1306_pacer.hpp"
+#include "SSD1306_list.hpp"
+#include "SSD1306_transition.hpp"
+#include "SSD1306_animation.hpp"
+#include "SSD1306_snapshot.hpp"
+#include "SSD1306_mirror.hpp"
+#include "SSD1306_trace.hpp"
+#include "alloc_check.hpp"
+#if defined(__cpp_impl_coroutine)
+#include "SSD1306_async.hpp"
+#endif
+
+namespace
+{
+  bool armed = false; ///<true while library code is running
+  const char *current_check = "";
+
+  // C and C++ runtime can allocate outside of checks (e.g. stdio buffers), it gets memory from here
+  alignas(max_align_t) unsigned char startup_heap[256 * 1024];
+  size_t startup_used = 0;
+
+  [[noreturn]] void Fail(const char *function)
+  {
+    // stdio could allocate, so plain write is used
+    const char *parts[] = { "alloc_check: ", function, " called in check: ", current_check, "\n" };
+    for (const char *part : parts)
+      {
+        ssize_t written = write(2, part, strlen(part));
+        (void) written;
+      }
+    abort();
+  }
+
+  void *Startup_Alloc(size_t size, size_t alignment = alignof(max_align_t))
+  {
+    // size is stored before returned block for realloc
+    size_t header = alignment > sizeof(size_t) ? alignment : sizeof(size_t);
+    size_t start = (startup_used + header + alignment - 1) / alignment * alignment;
+    if (start + size > sizeof(startup_heap))
+      {
+        return nullptr;
+      }
+    memcpy(&startup_heap[start - sizeof(size_t)], &size, sizeof(size_t));
+    startup_used = start + size;
+    return &startup_heap[start];
+  }
+
+  template<class Function>
+  void Check(const char *name, Function function)
+  {
+    current_check = name;
+    armed = true;
+    function();
+    armed = false;
+  }
+}
+
+extern "C" void *malloc(size_t size)
+{
+  if (armed)
+    {
+      Fail("malloc");
+    }
+  return Startup_Alloc(size);
+}
+
+extern "C" void *calloc(size_t count, size_t size)
+{
+  if (armed)
+    {
+      Fail("calloc");
+    }
+  void *memory = Startup_Alloc(count * size);
+  if (memory != nullptr)
+    {
+      memset(memory, 0, count * size);
+    }
+  return memory;
+}
+
+extern "C" void *realloc(void *old, size_t size)
+{
+  if (armed)
+    {
+      Fail("realloc");
+    }
+  void *memory = Startup_Alloc(size);
+  if (memory != nullptr && old != nullptr)
+    {
+      size_t old_size;
+      memcpy(&old_size, static_cast<unsigned char*>(old) - sizeof(size_t), sizeof(size_t));
+      memcpy(memory, old, old_size < size ? old_size : size);
+    }
+  return memory;
+}
+
+extern "C" int posix_memalign(void **memory, size_t alignment, size_t size)
+{
+  if (armed)
+    {
+      Fail("posix_memalign");
+    }
+  *memory = Startup_Alloc(size, alignment);
+  return *memory != nullptr ? 0 : 12; // ENOMEM
+}
+
+extern "C" void *aligned_alloc(size_t alignment, size_t size)
+{
+  if (armed)
+    {
+      Fail("aligned_alloc");
+    }
+  return Startup_Alloc(size, alignment);
+}
+
+extern "C" void free(void *memory)
+{
+  // startup memory is never reused
+  (void) memory;
+}
+
+void *operator new(size_t size)
+{
+  if (armed)
+    {
+      Fail("operator new");
+    }
+  return Startup_Alloc(size);
+}
+
+void *operator new[](size_t size)
+{
+  if (armed)
+    {
+      Fail("operator new[]");
+    }
+  return Startup_Alloc(size);
+}
+
+void *operator new(size_t size, const std::nothrow_t&) noexcept
+{
+  if (armed)
+    {
+      Fail("operator new(nothrow)");
+    }
+  return Startup_Alloc(size);
+}
+
+void *operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+  if (armed)
+    {
+      Fail("operator new[](nothrow)");
+    }
+  return Startup_Alloc(size);
+}
+
+void operator delete(void *memory) noexcept
+{
+  free(memory);
+}
+
+void operator delete[](void *memory) noexcept
+{
+  free(memory);
+}
+
+void operator delete(void *memory, size_t) noexcept
+{
+  free(memory);
+}
+
+void operator delete[](void *memory, size_t) noexcept
+{
+  free(memory);
+}
+
+namespace
+{
+  void *dummy;
+  uint32_t time_us = 0;
+  constexpr SSD1306::Init_Sequence init_128x32 =
+      SSD1306::Make_Init_Sequence({32, SSD1306::SEQ_NOREMAP});
+  constexpr SSD1306::Init_Sequence init_sh1106 = SSD1306::Make_Init_Sequence(
+      SSD1306::Default_Panel_Config(64, SSD1306::ALT_NOREMAP, SSD1306::CTRL_SH1106));
+  const uint8_t image[1024] = { 0x55 };
+
+  void Draw_All(SSD1306 &oled)
+  {
+    uint8_t waveform[] = { 1, 3, 4, 0, 7 };
+    oled.Fill(SSD1306::WHITE);
+    oled.Clean();
+    oled.Fill_Pattern(0xAA55AA55);
+    oled.Draw_Image(image);
+    oled.Invert_Region(3, 5, 70, 20);
+    (void) oled.Is_Equal(image);
+    oled.Draw_Pixel(5, 5, SSD1306::WHITE);
+    oled.Draw_Line_H(0, 10, 100, SSD1306::WHITE);
+    oled.Draw_Line_V(20, 0, 30, SSD1306::BLACK);
+    oled.Draw_Square(1, 1, 60, 30, SSD1306::WHITE);
+    oled.Draw_Waveform(0, 20, waveform, sizeof(waveform), SSD1306::WHITE);
+    oled.Fill_Rectangle(3, 5, 20, 13, Patterns::checker);
+    oled.Fill_Circle(64, 32, 10, SSD1306::WHITE);
+    oled.Fill_Circle(64, 32, 5, SSD1306::INVERT);
+    oled.Draw_Square(0, 0, 20, 10, SSD1306::INVERT);
+    oled.Copy_Region(0, 8, 128, 48, 0, 0);
+    oled.Copy_Region(10, 3, 50, 20, 12, 9);
+    const SSD1306::Point triangle[] = { { 10, 10 }, { 30, 10 }, { 10, 30 } };
+    oled.Fill_Polygon(triangle, 3, Patterns::gray_25);
+    oled.Set_Cursor(0, 0);
+    oled.Set_Font_size(Fonts::font_7x10);
+    oled.Write_String("Alloc");
+    oled.Set_Font_size(Fonts::font_11x18);
+    oled.Write_String_Inverted("free");
+    oled.Set_Font_size(Fonts::font_16x26);
+    oled.Write_String("!");
+  }
+
+  void Update_All(SSD1306 &oled)
+  {
+    oled.Update_Screen();
+    oled.Update_Region(10, 6, 3, 20); // vertical addressing
+    oled.Update_Region(0, 8, 128, 16); // whole pages
+    oled.Update_Region(5, 0, 100, 8); // horizontal addressing
+    oled.Enter_Partial_Mode(8, 8);
+    oled.Draw_Pixel(0, 0, SSD1306::WHITE);
+    oled.Update_Screen();
+    oled.Exit_Partial_Mode();
+    oled.Set_Brightness(10);
+    oled.Set_Clock(1, 8);
+    oled.Invert_Colors(true);
+    oled.Flip_Screen(true);
+    oled.Mirror_Screen(true);
+    oled.Display_Off();
+    oled.Display_On();
+    oled.Sleep();
+    oled.Resume();
+    oled.Draw_Pixel(1, 1, SSD1306::WHITE);
+    oled.Update_Dirty();
+  }
+
+#if defined(__cpp_impl_coroutine)
+  void Complete_Transfers(SSD1306 &oled, SSD1306_Async::Executor &executor)
+  {
+    executor.Run();
+    while (alloc_check::transfers_pending > 0)
+      {
+        alloc_check::transfers_pending--;
+        oled.Transfer_Complete();
+        executor.Run();
+      }
+  }
+
+  SSD1306_Async::Task Async_All(SSD1306_Async &async_oled)
+  {
+    bool ok = co_await async_oled.Initialize();
+    ok = co_await async_oled.Update_Screen() && ok;
+    ok = co_await async_oled.Update_Region(10, 6, 3, 20) && ok;
+    ok = co_await async_oled.Update_Region(5, 0, 100, 8) && ok;
+    ok = co_await async_oled.Enter_Partial_Mode(8, 8) && ok;
+    ok = co_await async_oled.Update_Screen() && ok;
+    ok = co_await async_oled.Exit_Partial_Mode() && ok;
+    ok = co_await async_oled.Set_Brightness(10) && ok;
+    ok = co_await async_oled.Set_Clock(1, 8) && ok;
+    ok = co_await async_oled.Invert_Colors(false) && ok;
+    ok = co_await async_oled.Flip_Screen(false) && ok;
+    ok = co_await async_oled.Mirror_Screen(false) && ok;
+    ok = co_await async_oled.Display_Off() && ok;
+    ok = co_await async_oled.Display_On() && ok;
+    ok = co_await async_oled.Sleep() && ok;
+    ok = co_await async_oled.Resume() && ok;
+    co_return ok;
+  }
+#endif
+}
+
+int main()
+{
+  static SSD1306 oled64(&dummy, 64);
+  static SSD1306 oled32(&dummy, init_128x32);
+  static SSD1306 sh1106(&dummy, init_sh1106);
+
+  Check("SSD1306 128x64", []()
+    {
+      SSD1306::Retry_Policy policy;
+      policy.attempts = 3;
+      oled64.Set_Retry_Policy(policy);
+      oled64.Initialize();
+      Draw_All(oled64);
+      Update_All(oled64);
+    });
+  Check("SSD1306 128x32", []()
+    {
+      oled32.Initialize();
+      Draw_All(oled32);
+      Update_All(oled32);
+    });
+  Check("SH1106", []()
+    {
+      sh1106.Initialize();
+      Draw_All(sh1106);
+      Update_All(sh1106);
+    });
+
+  Check("SSD1306_Frame_Pacer", []()
+    {
+      SSD1306_Frame_Pacer pacer(oled64, []() { return time_us; }, 60);
+      pacer.Synchronize();
+      pacer.Submit();
+      pacer.Poll();
+      time_us += 1000;
+      pacer.Submit();
+      pacer.Poll();
+    });
+
+  Check("SSD1306_List", []()
+    {
+      SSD1306_List list(oled64, [](void *, uint16_t) { return "Item"; }, nullptr, 100, 0, 0, 100, 64);
+      list.Draw();
+      list.Next();
+      list.Select(10);
+      list.Previous();
+      list.Select(50);
+      list.Set_Count(20);
+      oled64.Update_Dirty();
+    });
+
+  Check("SSD1306_Transition", []()
+    {
+      SSD1306_Transition transition(oled64);
+      const SSD1306_Transition::Effect effects[] = { SSD1306_Transition::SLIDE_UP,
+          SSD1306_Transition::SLIDE_DOWN, SSD1306_Transition::WIPE_LEFT, SSD1306_Transition::WIPE_RIGHT,
+          SSD1306_Transition::WIPE_UP, SSD1306_Transition::WIPE_DOWN, SSD1306_Transition::DISSOLVE };
+      for (SSD1306_Transition::Effect effect : effects)
+        {
+          transition.Start(image, effect);
+          transition.Step();
+          transition.Finish();
+        }
+    });
+
+  Check("SSD1306_Animator", []()
+    {
+      static const SSD1306_Animator::Keyframe keyframes[] = { { 0, -4, 0, 0 }, { 1000, 120, 60, 1 } };
+      SSD1306_Animator animator(oled64, []() { return time_us; });
+      int8_t slot = animator.Start(SSD1306_Animator::Animation {
+          [](void *, SSD1306 &display, int16_t x, int16_t y, uint8_t frame)
+            {
+              display.Fill_Circle(uint8_t(x + 4), uint8_t(y + 4), 4, frame ? SSD1306::WHITE : SSD1306::INVERT);
+            }, nullptr, 8, 8, keyframes, 2, true });
+      animator.Tick();
+      time_us += 300;
+      animator.Tick();
+      animator.Stop(slot);
+      animator.Tick();
+    });
+
+  Check("SSD1306_Snapshot", []()
+    {
+      static uint8_t shown[SSD1306_Snapshot::size], now[SSD1306_Snapshot::size], output[2048];
+      uint16_t size;
+      oled64.Take_Snapshot(shown);
+      oled64.Draw_Pixel(5, 5, SSD1306::Color::INVERT);
+      oled64.Take_Snapshot(now);
+      oled64.Mark_Changes(shown);
+      oled64.Update_Dirty();
+      SSD1306_Snapshot::Encode_Delta(shown, now, output, sizeof(output), size);
+      SSD1306_Snapshot::Apply_Delta(shown, output, size);
+      SSD1306_Snapshot::Encode_Rle(now, output, sizeof(output), size);
+      SSD1306_Snapshot::Decode_Rle(output, size, now);
+      oled64.Take_Snapshot(shown);
+      oled64.Set_Shadow(shown);
+      oled64.Draw_Image(now);
+      oled64.Draw_Pixel(6, 6, SSD1306::Color::INVERT);
+      oled64.Update_Changed();
+      oled64.Set_Shadow(nullptr);
+    });
+
+  Check("SSD1306_Mirror", []()
+    {
+      static SSD1306_Mirror::Decoder decoder;
+      static uint8_t pbm[SSD1306_Snapshot::pbm_size];
+      SSD1306_Mirror mirror(oled64, [](void *context, const uint8_t *data, uint16_t size)
+        {
+          static_cast<SSD1306_Mirror::Decoder*>(context)->Feed(data, size);
+          return true;
+        }, &decoder, 2);
+      oled64.Update_Screen();
+      oled64.Draw_Pixel(7, 7, SSD1306::Color::INVERT);
+      oled64.Update_Dirty();
+      mirror.Request_Keyframe();
+      oled64.Update_Region(0, 0, 8, 8);
+      SSD1306_Snapshot::Encode_Pbm(decoder.Image(), pbm);
+    });
+
+  Check("SSD1306_Trace", []()
+    {
+      static uint32_t printed = 0;
+      SSD1306_Trace trace(oled64);
+      oled64.Initialize();
+      oled64.Set_Brightness(20);
+      oled64.Draw_Pixel(8, 8, SSD1306::Color::INVERT);
+      oled64.Update_Dirty();
+      trace.Print([](void *context, const char *line)
+        {
+          *static_cast<uint32_t*>(context) += uint32_t(strlen(line));
+        }, &printed);
+    });
+
+#if defined(__cpp_impl_coroutine)
+  static SSD1306_Async::Executor executor;
+  static SSD1306_Async async_oled(oled64, executor);
+  static bool async_ok = false;
+  Check("SSD1306_Async", []()
+    {
+      SSD1306_Async::Task task = Async_All(async_oled);
+      executor.Start(task);
+      Complete_Transfers(oled64, executor);
+      async_ok = task.Is_Valid() && task.Result();
+    });
+  if (!async_ok)
+    {
+      printf("alloc_check: awaitable functions failed\n");
+      return 1;
+    }
+#endif
+
+  printf("alloc_check: OK, heap not used (%u command bytes, %u data bytes sent)\n",
+      unsigned(alloc_check::command_bytes), unsigned(alloc_check::data_bytes));
+  return 0;
+}
@@ -0,0 +1,217 @@
+/**
+ ******************************************************************************
+ * @file    emulator.cpp
+ * @author  agent
+ * @date    17.10.2026
+ * @brief   Emulator of display controller memory for unit tests
+ ******************************************************************************
+ * <h2><center>&copy; COPYRIGHT(c) 2026 agent
+ * </center></h2>
+ *
+ *Permission is hereby granted, free of charge,
+ *to any person obtaining a copy of this software and associated documentation files
+ *(the "Software"), to deal in the Software without restriction,
+ *including without limitation the rights to use, copy, modify,
+ *merge, publish, distribute, sublicense, and/or sell copies of
+ *the Software, and to permit persons to whom the Software is furnished to do so,
+ *subject to the following conditions:
+ *
+ *The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ *THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ *INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ *PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ *FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************************************
+ */
+
+
+#include "emulator.hpp"
+
+namespace testing
+{
+  namespace ssd1306
+  {
+    Panel_Emulator panel;
+  }
+
+  void Panel_Emulator::Reset(bool sh1106, uint8_t rows)
+  {
+    *this = Panel_Emulator();
+    for (auto &p : ram)
+      {
+        p.fill(0);
+      }
+    this->sh1106 = sh1106;
+    this->rows = rows;
+    columns = sh1106 ? 132 : 128;
+    column_end = columns - 1;
+    column_offset = sh1106 ? 2 : 0;
+  }
+
+  uint8_t Panel_Emulator::Arguments_Of(uint8_t command) const
+  {
+    if (sh1106)
+      {
+        switch (command)
+          {
+          case 0x81: case 0xA8: case 0xAD: case 0xD3: case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+            return 1;
+          default:
+            return 0;
+          }
+      }
+    switch (command)
+      {
+      case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xAD: case 0xD3: case 0xD5:
+      case 0xD8: case 0xD9: case 0xDA: case 0xDB:
+        return 1;
+      case 0x21: case 0x22: case 0xA3:
+        return 2;
+      case 0x29: case 0x2A:
+        return 5;
+      case 0x26: case 0x27:
+        return 6;
+      default:
+        return 0;
+      }
+  }
+
+  void Panel_Emulator::Command(uint8_t byte)
+  {
+    if (arguments_expected > arguments_received)
+      {
+        arguments[arguments_received++] = byte;
+        if (arguments_received == arguments_expected)
+          {
+            Execute();
+          }
+        return;
+      }
+    command = byte;
+    arguments_received = 0;
+    arguments_expected = Arguments_Of(byte);
+    if (arguments_expected == 0)
+      {
+        Execute();
+      }
+  }
+
+  void Panel_Emulator::Execute(void)
+  {
+    bool horizontal_commands = !sh1106;
+    if (command <= 0x0F && (addressing_mode == 2 || sh1106))
+      {
+        column = (column & 0xF0) | command;
+      }
+    else if (command >= 0x10 && command <= 0x1F && (addressing_mode == 2 || sh1106))
+      {
+        column = uint8_t((column & 0x0F) | ((command & 0x0F) << 4));
+      }
+    else if (command >= 0x40 && command <= 0x7F)
+      {
+        start_line = command & 0x3F;
+      }
+    else if (command >= 0xB0 && command <= 0xB7 && (addressing_mode == 2 || sh1106))
+      {
+        page = command & 0x07;
+      }
+    else if (command == 0x20 && horizontal_commands)
+      {
+        addressing_mode = arguments[0] & 0x03;
+      }
+    else if (command == 0x21 && horizontal_commands)
+      {
+        column_start = column = arguments[0] & 0x7F;
+        column_end = arguments[1] & 0x7F;
+      }
+    else if (command == 0x22 && horizontal_commands)
+      {
+        page_start = page = arguments[0] & 0x07;
+        page_end = arguments[1] & 0x07;
+      }
+    else if (command == 0x81)
+      {
+        contrast = arguments[0];
+      }
+    else if (command == 0xA6 || command == 0xA7)
+      {
+        inverted = command == 0xA7;
+      }
+    else if (command == 0xA8)
+      {
+        multiplex = arguments[0] & 0x3F;
+      }
+    else if (command == 0xAE || command == 0xAF)
+      {
+        display_on = command == 0xAF;
+      }
+    else if (command == 0xC0 || command == 0xC8)
+      {
+        com_remap = command == 0xC8;
+      }
+    else if (command == 0xD3)
+      {
+        display_offset = arguments[0] & 0x3F;
+      }
+  }
+
+  void Panel_Emulator::Data(uint8_t byte)
+  {
+    if (column < max_columns)
+      {
+        ram[page][column] = byte;
+      }
+    data_bytes++;
+
+    if (addressing_mode == 0 && !sh1106)
+      {
+        if (column >= column_end)
+          {
+            column = column_start;
+            page = (page >= page_end) ? page_start : page + 1;
+          }
+        else
+          {
+            column++;
+          }
+      }
+    else if (addressing_mode == 1 && !sh1106)
+      {
+        if (page >= page_end)
+          {
+            page = page_start;
+            column = (column >= column_end) ? column_start : column + 1;
+          }
+        else
+          {
+            page++;
+          }
+      }
+    else if (column < columns - 1)
+      {
+        column++;
+      }
+  }
+
+  uint8_t Panel_Emulator::Ram(uint8_t column, uint8_t page) const
+  {
+    return ram[page][column];
+  }
+
+  bool Panel_Emulator::Pixel(uint8_t x, uint8_t y) const
+  {
+    uint8_t com = rows - 1 - y;
+    uint8_t mux = multiplex + 1;
+    uint8_t scanned = com_remap ? (mux - 1 + display_offset - com) & 0x3F : (com + display_offset) & 0x3F;
+    if (scanned >= mux)
+      {
+        return false; //COM line is not driven
+      }
+    uint8_t row = (scanned + start_line) % 64;
+    return ram[row / 8][x + column_offset] & (1 << (row % 8));
+  }
+}
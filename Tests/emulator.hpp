@@ -0,0 +1,101 @@
+/**
+ ******************************************************************************
+ * @file    emulator.hpp
+ * @author  agent
+ * @date    17.10.2026
+ * @brief   Emulator of display controller memory for unit tests
+ ******************************************************************************
+ * <h2><center>&copy; COPYRIGHT(c) 2026 agent
+ * </center></h2>
+ *
+ *Permission is hereby granted, free of charge,
+ *to any person obtaining a copy of this software and associated documentation files
+ *(the "Software"), to deal in the Software without restriction,
+ *including without limitation the rights to use, copy, modify,
+ *merge, publish, distribute, sublicense, and/or sell copies of
+ *the Software, and to permit persons to whom the Software is furnished to do so,
+ *subject to the following conditions:
+ *
+ *The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ *THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ *INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ *PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ *FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************************************
+ */
+
+#ifndef EMULATOR_HPP_
+#define EMULATOR_HPP_
+
+#include <stdint.h>
+#include <array>
+
+namespace testing
+{
+  /// Interprets command and data stream like display controller does, so tests can check
+  /// what would be visible on the panel instead of raw bytes.
+  class Panel_Emulator
+  {
+  public:
+    static const uint8_t max_columns = 132;
+    static const uint8_t pages = 8;
+
+    /// Clears memory and sets state after reset of controller
+    /// @param sh1106: emulate SH1106 (132 columns, page addressing only)
+    /// @param rows: number of COM lines connected to panel
+    void Reset(bool sh1106 = false, uint8_t rows = 64);
+
+    void Command(uint8_t byte);
+    void Data(uint8_t byte);
+
+    /// Byte of display memory
+    uint8_t Ram(uint8_t column, uint8_t page) const;
+
+    /// Pixel as it is visible on panel (column offset, multiplex ratio, display offset, start line and
+    /// COM scan direction are taken into account). Panel is wired so that with remapped scan (0xC8)
+    /// first line of RAM is on top.
+    bool Pixel(uint8_t x, uint8_t y) const;
+
+    bool display_on = false;
+    bool inverted = false;
+    uint8_t contrast = 0x7f;
+    uint8_t addressing_mode = 2; ///<0-horizontal, 1-vertical, 2-page
+    uint8_t start_line = 0;
+    uint8_t multiplex = 63;
+    uint8_t display_offset = 0;
+    bool com_remap = false; ///<COM scan direction, true after 0xC8
+    uint8_t column_offset = 0; ///<RAM column shown as first visible pixel
+    uint32_t data_bytes = 0; ///<number of bytes written to memory since reset
+
+  private:
+    std::array<std::array<uint8_t, max_columns>, pages> ram;
+    bool sh1106 = false;
+    uint8_t rows = 64;
+    uint8_t columns = 128;
+    uint8_t column = 0;
+    uint8_t page = 0;
+    uint8_t column_start = 0;
+    uint8_t column_end = 127;
+    uint8_t page_start = 0;
+    uint8_t page_end = 7;
+
+    uint8_t command = 0; ///<command waiting for arguments
+    uint8_t arguments[6];
+    uint8_t arguments_expected = 0;
+    uint8_t arguments_received = 0;
+
+    uint8_t Arguments_Of(uint8_t command) const;
+    void Execute(void);
+  };
+
+  namespace ssd1306
+  {
+    extern Panel_Emulator panel;
+  }
+}
+
+#endif /* EMULATOR_HPP_ */
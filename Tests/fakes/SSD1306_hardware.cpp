@@ -31,14 +31,54 @@
 #include "SSD1306.hpp"
 #include <vector>
 #include "testing.hpp"
+#include "emulator.hpp"
 
+namespace
+{
+  // Passes bytes to recorder and emulator until injected NACK.
+  // Returns number of delivered bytes.
+  uint16_t Deliver (bool command, const uint8_t *bytes, uint16_t size)
+  {
+    for (uint16_t i = 0; i < size; i++)
+      {
+        if (testing::ssd1306::nack_times > 0
+            && testing::ssd1306::bytes_delivered == testing::ssd1306::nack_at_byte)
+          {
+            testing::ssd1306::nack_times--;
+            return i;
+          }
+        testing::ssd1306::data.push_back(bytes[i]);
+        if (command)
+          {
+            testing::ssd1306::panel.Command(bytes[i]);
+          }
+        else
+          {
+            testing::ssd1306::panel.Data(bytes[i]);
+          }
+        testing::ssd1306::bytes_delivered++;
+      }
+    return size;
+  }
+}
 
-void SSD1306::Write_Command (uint8_t com)
+bool SSD1306::Transmit (uint8_t control_byte, const uint8_t *data, uint16_t size)
 {
-  testing::ssd1306::data.push_back(com);
+  if (Deliver(control_byte == control_b_command, data, size) < size)
+    {
+      last_error = testing::ssd1306::nack_error;
+      return false;
+    }
+  return true;
 }
 
-void SSD1306::Write_Data (std::array<uint8_t, SSD1306::buffer_size>  &data)
+bool SSD1306::Start_Transfer (uint8_t control_byte, const uint8_t *data, uint16_t size)
 {
-  testing::ssd1306::data.insert(testing::ssd1306::data.end(), data.begin(), data.end());
+  if (Deliver(control_byte == control_b_command, data, size) < size)
+    {
+      last_error = testing::ssd1306::nack_error;
+      return false;
+    }
+  testing::ssd1306::transfers_pending++;
+  return true;
 }
@@ -29,3 +29,5 @@
  */
 
 #define SSD1306_I2C_Typedef void
+#define SSD1306_STATISTICS 1
+#define SSD1306_TRACE 1
@@ -0,0 +1,384 @@
+/**
+ ******************************************************************************
+ * @file    fuzz/fuzz_drawing.cpp
+ * @author  agent
+ * @date    17.10.2026
+ * @brief   Fuzz target for drawing and text functions
+ ******************************************************************************
+ * <h2><center>&copy; COPYRIGHT(c) 2026 agent
+ * </center></h2>
+ *
+ *Permission is hereby granted, free of charge,
+ *to any person obtaining a copy of this software and associated documentation files
+ *(the "Software"), to deal in the Software without restriction,
+ *including without limitation the rights to use, copy, modify,
+ *merge, publish, distribute, sublicense, and/or sell copies of
+ *the Software, and to permit persons to whom the Software is furnished to do so,
+ *subject to the following conditions:
+ *
+ *The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ *THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ *INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ *PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ *FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************************************
+ *******************************************************************************
+ *
+ * Input bytes are decoded into sequence of drawing and text calls with arbitrary coordinates, sizes,
+ * colors and characters. Every call is repeated on testing::Reference_Canvas; buffer and, after
+ * SSD1306::Update_Dirty, emulated panel RAM have to be the same as reference image, otherwise program
+ * aborts. Address sanitizer catches reads and writes outside of buffer and font tables.
+ * Build with libFuzzer (from repository root):
+ *
+ *   clang++ -std=c++14 -g -O1 -fsanitize=fuzzer,address,undefined -DSSD1306_LIBFUZZER \
+ *       -IInc -ITests -ITests/fakes Src/SSD1306.cpp Tests/fakes/SSD1306_hardware.cpp \
+ *       Tests/testing.cpp Tests/emulator.cpp Tests/reference.cpp Tests/fuzz/fuzz_drawing.cpp -o fuzz_drawing
+ *   ./fuzz_drawing -max_len=256
+ *
+ * Without libFuzzer the same file builds to standalone program running seeded random inputs:
+ *
+ *   g++ -std=c++14 -g -O1 -fsanitize=address,undefined -IInc -ITests -ITests/fakes \
+ *       Src/SSD1306.cpp Tests/fakes/SSD1306_hardware.cpp Tests/testing.cpp Tests/emulator.cpp \
+ *       Tests/reference.cpp Tests/fuzz/fuzz_drawing.cpp -o fuzz_drawing
+ *   ./fuzz_drawing 100000            runs 100000 random inputs
+ *   ./fuzz_drawing crash-1234        replays input saved by libFuzzer
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include "SSD1306.hpp"
+#include "testing.hpp"
+#include "emulator.hpp"
+#include "reference.hpp"
+
+namespace
+{
+  void *dummy_fuzz;
+  SSD1306 oled_64(&dummy_fuzz, 64);
+  SSD1306 oled_32(&dummy_fuzz, 32);
+
+  const Fonts::FontDef fonts[] = { Fonts::font_7x10, Fonts::font_11x18, Fonts::font_16x26 };
+
+  /// Reads input byte by byte, returns zeros after end of input
+  class Input
+  {
+  public:
+    Input(const uint8_t *data, size_t size) :
+        data(data), size(size)
+    {
+    }
+
+    bool Empty(void) const
+    {
+      return position >= size;
+    }
+
+    uint8_t Byte(void)
+    {
+      return position < size ? data[position++] : 0;
+    }
+
+    int16_t Position(void)
+    {
+      return int16_t(int8_t(Byte()) * 2);
+    }
+
+    Patterns::PatternDef Pattern(void)
+    {
+      Patterns::PatternDef pattern;
+      for (uint8_t &column : pattern.Columns)
+        {
+          column = Byte();
+        }
+      return pattern;
+    }
+
+    SSD1306::Color Color(void)
+    {
+      const SSD1306::Color colors[] = { SSD1306::Color::BLACK, SSD1306::Color::WHITE, SSD1306::Color::INVERT };
+      return colors[Byte() % 3];
+    }
+
+  private:
+    const uint8_t *data;
+    size_t size;
+    size_t position = 0;
+  };
+
+  void Fail(const std::string &what)
+  {
+    fprintf(stderr, "fuzz_drawing: %s\n", what.c_str());
+    abort();
+  }
+
+  void Compare(SSD1306 &oled, const testing::Reference_Canvas &reference, uint8_t height)
+  {
+    uint8_t image[128 * 64 / 8];
+    oled.Take_Snapshot(image);
+    const std::string difference = reference.Compare(image);
+    if (!difference.empty())
+      {
+        Fail("buffer: " + difference);
+      }
+    oled.Update_Dirty();
+    const std::vector<uint8_t> expected = reference.Image();
+    for (uint8_t page = 0; page < height / 8; page++)
+      {
+        for (uint8_t column = 0; column < 128; column++)
+          {
+            if (testing::ssd1306::panel.Ram(column, page) != expected[page * 128 + column])
+              {
+                Fail("panel differs from reference at column " + std::to_string(column) + " page "
+                    + std::to_string(page));
+              }
+          }
+      }
+    testing::ssd1306::data.clear();
+  }
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+  Input input(data, size);
+  const uint8_t height = (input.Byte() & 1) ? 32 : 64;
+  SSD1306 &oled = height == 64 ? oled_64 : oled_32;
+  testing::Reference_Canvas reference(height);
+
+  testing::ssd1306::panel.Reset(false, height);
+  oled.Initialize();
+  oled.Set_Font_size(Fonts::font_7x10);
+  oled.Set_Cursor(0, 0);
+  testing::ssd1306::data.clear();
+
+  while (!input.Empty())
+    {
+      const uint8_t op = input.Byte();
+      switch (op % 18)
+        {
+        case 0:
+          {
+            uint8_t x = input.Byte(), y = input.Byte();
+            SSD1306::Color c = input.Color();
+            oled.Draw_Pixel(x, y, c);
+            reference.Draw_Pixel(x, y, c);
+            break;
+          }
+        case 1:
+          {
+            uint8_t x = input.Byte(), y = input.Byte(), width = input.Byte();
+            SSD1306::Color c = input.Color();
+            oled.Draw_Line_H(x, y, width, c);
+            reference.Draw_Line_H(x, y, width, c);
+            break;
+          }
+        case 2:
+          {
+            uint8_t x = input.Byte(), y = input.Byte(), height = input.Byte();
+            SSD1306::Color c = input.Color();
+            oled.Draw_Line_V(x, y, height, c);
+            reference.Draw_Line_V(x, y, height, c);
+            break;
+          }
+        case 3:
+          {
+            uint8_t x = input.Byte(), y = input.Byte(), x2 = input.Byte(), y2 = input.Byte();
+            SSD1306::Color c = input.Color();
+            oled.Draw_Square(x, y, x2, y2, c);
+            reference.Draw_Square(x, y, x2, y2, c);
+            break;
+          }
+        case 4:
+          {
+            uint8_t x = input.Byte(), y = input.Byte(), size = input.Byte() % 32;
+            SSD1306::Color c = input.Color();
+            uint8_t values[32];
+            for (uint8_t i = 0; i < size; i++)
+              {
+                values[i] = input.Byte();
+              }
+            oled.Draw_Waveform(x, y, values, size, c);
+            reference.Draw_Waveform(x, y, values, size, c);
+            break;
+          }
+        case 5:
+          {
+            uint8_t x = input.Byte(), y = input.Byte();
+            oled.Set_Cursor(x, y);
+            reference.Set_Cursor(x, y);
+            break;
+          }
+        case 6:
+        case 7:
+          {
+            // any bytes, including control characters and ones above 127
+            char text[16];
+            uint8_t length = input.Byte() % sizeof(text);
+            for (uint8_t i = 0; i < length; i++)
+              {
+                text[i] = char(input.Byte());
+                if (text[i] == '\0')
+                  {
+                    text[i] = '\n';
+                  }
+              }
+            text[length] = '\0';
+            if (op % 18 == 6)
+              {
+                oled.Write_String(text);
+                reference.Write_String(text);
+              }
+            else
+              {
+                oled.Write_String_Inverted(text);
+                reference.Write_String_Inverted(text);
+              }
+            break;
+          }
+        case 8:
+          {
+            const Fonts::FontDef &font = fonts[input.Byte() % 3];
+            oled.Set_Font_size(font);
+            reference.Set_Font_size(font);
+            break;
+          }
+        case 9:
+          {
+            SSD1306::Color c = input.Color();
+            oled.Fill(c);
+            reference.Fill(c);
+            break;
+          }
+        case 10:
+          {
+            uint8_t x = input.Byte(), y = input.Byte(), width = input.Byte(), height = input.Byte();
+            SSD1306::Color c = input.Color();
+            oled.Fill_Rectangle(x, y, width, height, c);
+            reference.Fill_Rectangle(x, y, width, height, c);
+            break;
+          }
+        case 11:
+          {
+            uint8_t x = input.Byte(), y = input.Byte(), width = input.Byte(), height = input.Byte();
+            oled.Invert_Region(x, y, width, height);
+            reference.Invert_Region(x, y, width, height);
+            break;
+          }
+        case 12:
+          {
+            uint8_t x = input.Byte(), y = input.Byte(), width = input.Byte(), height = input.Byte();
+            Patterns::PatternDef pattern = input.Pattern();
+            oled.Fill_Rectangle(x, y, width, height, pattern);
+            reference.Fill_Rectangle(x, y, width, height, pattern);
+            break;
+          }
+        case 13:
+          {
+            uint8_t x = input.Byte(), y = input.Byte(), width = input.Byte(), height = input.Byte();
+            int16_t to_x = input.Position(), to_y = input.Position();
+            oled.Copy_Region(x, y, width, height, to_x, to_y);
+            reference.Copy_Region(x, y, width, height, to_x, to_y);
+            break;
+          }
+        case 14:
+          {
+            uint8_t x = input.Byte(), y = input.Byte(), radius = input.Byte();
+            SSD1306::Color c = input.Color();
+            oled.Fill_Circle(x, y, radius, c);
+            reference.Fill_Circle(x, y, radius, c);
+            break;
+          }
+        case 15:
+          {
+            SSD1306::Point points[SSD1306_POLYGON_MAX_POINTS + 1];
+            uint8_t count = input.Byte() % (SSD1306_POLYGON_MAX_POINTS + 2);
+            for (uint8_t i = 0; i < count; i++)
+              {
+                points[i] = SSD1306::Point { input.Position(), input.Position() };
+              }
+            SSD1306::Color c = input.Color();
+            oled.Fill_Polygon(points, count, c);
+            reference.Fill_Polygon(points, count, c);
+            break;
+          }
+        case 16:
+          {
+            // image made of repeated pattern, so it depends on few input bytes
+            uint8_t image[128 * 64 / 8];
+            Patterns::PatternDef pattern = input.Pattern();
+            for (int i = 0; i < int(sizeof(image)); i++)
+              {
+                image[i] = uint8_t(pattern.Columns[i % 8] + i / 8);
+              }
+            uint8_t x = input.Byte(), y = input.Byte(), width = input.Byte(), height = input.Byte();
+            oled.Draw_Image_Region(image, x, y, width, height);
+            reference.Draw_Image_Region(image, x, y, width, height);
+            break;
+          }
+        default:
+          {
+            uint32_t pattern = uint32_t(input.Byte()) | uint32_t(input.Byte()) << 8 | uint32_t(input.Byte()) << 16
+                | uint32_t(input.Byte()) << 24;
+            oled.Fill_Pattern(pattern);
+            reference.Fill_Pattern(pattern);
+            break;
+          }
+        }
+      if (op & 0x80)
+        {
+          Compare(oled, reference, height);
+        }
+    }
+  Compare(oled, reference, height);
+  return 0;
+}
+
+#if !defined(SSD1306_LIBFUZZER)
+int main(int argc, char *argv[])
+{
+  if (argc > 1 && (argv[1][0] < '0' || argv[1][0] > '9'))
+    {
+      // replay of saved inputs
+      for (int i = 1; i < argc; i++)
+        {
+          FILE *file = fopen(argv[i], "rb");
+          if (file == nullptr)
+            {
+              perror(argv[i]);
+              return 1;
+            }
+          std::vector<uint8_t> data;
+          int c;
+          while ((c = fgetc(file)) != EOF)
+            {
+              data.push_back(uint8_t(c));
+            }
+          fclose(file);
+          LLVMFuzzerTestOneInput(data.data(), data.size());
+        }
+      return 0;
+    }
+
+  const long runs = argc > 1 ? atol(argv[1]) : 10000;
+  srand(1);
+  std::vector<uint8_t> data;
+  for (long run = 0; run < runs; run++)
+    {
+      data.resize(rand() % 256);
+      for (uint8_t &byte : data)
+        {
+          byte = uint8_t(rand());
+        }
+      LLVMFuzzerTestOneInput(data.data(), data.size());
+    }
+  printf("fuzz_drawing: %ld inputs passed\n", runs);
+  return 0;
+}
+#endif
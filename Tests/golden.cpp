@@ -0,0 +1,250 @@
+/**
+ ******************************************************************************
+ * @file    golden.cpp
+ * @author  agent
+ * @date    17.10.2026
+ * @brief   Golden image comparison for unit tests
+ ******************************************************************************
+ * <h2><center>&copy; COPYRIGHT(c) 2026 agent
+ * </center></h2>
+ *
+ *Permission is hereby granted, free of charge,
+ *to any person obtaining a copy of this software and associated documentation files
+ *(the "Software"), to deal in the Software without restriction,
+ *including without limitation the rights to use, copy, modify,
+ *merge, publish, distribute, sublicense, and/or sell copies of
+ *the Software, and to permit persons to whom the Software is furnished to do so,
+ *subject to the following conditions:
+ *
+ *The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ *THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ *INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ *PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ *FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************************************
+ */
+
+#include <stdlib.h>
+#include <fstream>
+#include <sstream>
+#include "golden.hpp"
+#include "emulator.hpp"
+#include "SSD1306.hpp"
+#include "SSD1306_snapshot.hpp"
+
+namespace testing
+{
+  namespace golden
+  {
+    namespace
+    {
+      const uint8_t width = 128;
+      const uint8_t height = 64;
+
+      bool Pixel(const std::vector<uint8_t> &image, uint8_t x, uint8_t y)
+      {
+        return (image[(y / 8) * width + x] >> (y % 8)) & 1;
+      }
+
+      std::string Path(const std::string &name)
+      {
+        const char *dir = getenv("SSD1306_GOLDEN_DIR");
+        return std::string(dir != nullptr ? dir : "Tests/golden") + "/" + name;
+      }
+
+      bool Updating(void)
+      {
+        const char *update = getenv("SSD1306_UPDATE_GOLDEN");
+        return update != nullptr && std::string(update) == "1";
+      }
+
+      bool Write_File(const std::string &path, const std::string &text)
+      {
+        std::ofstream file(path, std::ios::binary);
+        file << text;
+        return bool(file);
+      }
+
+      // Skips whitespace and comments of PBM header
+      void Skip_Blank(std::istream &in)
+      {
+        while (in)
+          {
+            int c = in.peek();
+            if (c == '#')
+              {
+                std::string comment;
+                std::getline(in, comment);
+              }
+            else if (c == ' ' || c == '\t' || c == '\r' || c == '\n')
+              {
+                in.get();
+              }
+            else
+              {
+                return;
+              }
+          }
+      }
+    }
+
+    std::vector<uint8_t> Buffer_Image(const SSD1306 &display)
+    {
+      std::vector<uint8_t> image(SSD1306_Snapshot::size);
+      display.Take_Snapshot(image.data());
+      return image;
+    }
+
+    std::vector<uint8_t> Panel_Image(void)
+    {
+      std::vector<uint8_t> image(SSD1306_Snapshot::size, 0);
+      for (uint8_t y = 0; y < height; y++)
+        {
+          for (uint8_t x = 0; x < width; x++)
+            {
+              if (ssd1306::panel.Pixel(x, y))
+                {
+                  image[(y / 8) * width + x] |= uint8_t(1 << (y % 8));
+                }
+            }
+        }
+      return image;
+    }
+
+    std::string To_Plain_Pbm(const std::vector<uint8_t> &image)
+    {
+      std::string pbm = "P1\n128 64\n";
+      for (uint8_t y = 0; y < height; y++)
+        {
+          for (uint8_t x = 0; x < width; x++)
+            {
+              pbm += Pixel(image, x, y) ? '1' : '0';
+            }
+          pbm += '\n';
+        }
+      return pbm;
+    }
+
+    bool From_Pbm(const std::string &pbm, std::vector<uint8_t> &image)
+    {
+      std::istringstream in(pbm);
+      std::string magic;
+      unsigned columns = 0, rows = 0;
+      in >> magic;
+      Skip_Blank(in);
+      in >> columns;
+      Skip_Blank(in);
+      in >> rows;
+      if (!in || (magic != "P1" && magic != "P4") || columns != width || rows != height)
+        {
+          return false;
+        }
+      image.assign(SSD1306_Snapshot::size, 0);
+      if (magic == "P4")
+        {
+          in.get(); // single whitespace before raster
+          for (uint8_t y = 0; y < height; y++)
+            {
+              for (uint8_t x = 0; x < width; x += 8)
+                {
+                  int bits = in.get();
+                  if (bits < 0)
+                    {
+                      return false;
+                    }
+                  for (uint8_t i = 0; i < 8; i++)
+                    {
+                      if (bits & (0x80 >> i))
+                        {
+                          image[(y / 8) * width + x + i] |= uint8_t(1 << (y % 8));
+                        }
+                    }
+                }
+            }
+          return true;
+        }
+      for (uint8_t y = 0; y < height; y++)
+        {
+          for (uint8_t x = 0; x < width; x++)
+            {
+              Skip_Blank(in);
+              int c = in.get();
+              if (c != '0' && c != '1')
+                {
+                  return false;
+                }
+              if (c == '1')
+                {
+                  image[(y / 8) * width + x] |= uint8_t(1 << (y % 8));
+                }
+            }
+        }
+      return true;
+    }
+
+    std::string Diff(const std::vector<uint8_t> &image, const std::vector<uint8_t> &golden)
+    {
+      uint32_t different = 0;
+      uint8_t left = width, right = 0, top = height, bottom = 0;
+      for (uint8_t y = 0; y < height; y++)
+        {
+          for (uint8_t x = 0; x < width; x++)
+            {
+              if (Pixel(image, x, y) != Pixel(golden, x, y))
+                {
+                  different++;
+                  left = x < left ? x : left;
+                  right = x > right ? x : right;
+                  top = y < top ? y : top;
+                  bottom = y > bottom ? y : bottom;
+                }
+            }
+        }
+      if (different == 0)
+        {
+          return "";
+        }
+      std::ostringstream report;
+      report << different << " pixels differ in x " << unsigned(left) << "-" << unsigned(right)
+          << ", y " << unsigned(top) << "-" << unsigned(bottom) << "\n";
+      for (uint8_t y = top; y <= bottom; y++)
+        {
+          for (uint8_t x = left; x <= right; x++)
+            {
+              bool lit = Pixel(image, x, y);
+              bool expected = Pixel(golden, x, y);
+              report << (lit == expected ? (lit ? '#' : '.') : (lit ? '+' : '-'));
+            }
+          report << '\n';
+        }
+      return report.str();
+    }
+
+    std::string Compare(const std::string &name, const std::vector<uint8_t> &image)
+    {
+      const std::string path = Path(name + ".pbm");
+      if (Updating())
+        {
+          return Write_File(path, To_Plain_Pbm(image)) ? "" : "cannot write " + path;
+        }
+      std::ifstream file(path, std::ios::binary);
+      std::vector<uint8_t> golden;
+      if (!file || !From_Pbm(std::string(std::istreambuf_iterator<char>(file), {}), golden))
+        {
+          return "missing or unreadable golden " + path + " (run with SSD1306_UPDATE_GOLDEN=1 to create it)";
+        }
+      const std::string diff = Diff(image, golden);
+      if (diff.empty())
+        {
+          return "";
+        }
+      const std::string actual = Path(name + ".actual.pbm");
+      Write_File(actual, To_Plain_Pbm(image));
+      return name + ": " + diff + "actual image: " + actual;
+    }
+  }
+}
@@ -0,0 +1,71 @@
+/**
+ ******************************************************************************
+ * @file    golden.hpp
+ * @author  agent
+ * @date    17.10.2026
+ * @brief   Golden image comparison for unit tests
+ ******************************************************************************
+ * <h2><center>&copy; COPYRIGHT(c) 2026 agent
+ * </center></h2>
+ *
+ *Permission is hereby granted, free of charge,
+ *to any person obtaining a copy of this software and associated documentation files
+ *(the "Software"), to deal in the Software without restriction,
+ *including without limitation the rights to use, copy, modify,
+ *merge, publish, distribute, sublicense, and/or sell copies of
+ *the Software, and to permit persons to whom the Software is furnished to do so,
+ *subject to the following conditions:
+ *
+ *The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ *THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ *INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ *PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ *FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************************************
+ */
+
+#ifndef GOLDEN_HPP_
+#define GOLDEN_HPP_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+class SSD1306;
+
+namespace testing
+{
+  /// Images are 128x64, in layout of SSD1306::Draw_Image (columns of 8 pixels, page by page).
+  /// Goldens are kept in Tests/golden as plain PBM (P1), so their changes can be reviewed in diff.
+  /// Directory can be changed with SSD1306_GOLDEN_DIR environment variable, goldens are
+  /// written again instead of compared if SSD1306_UPDATE_GOLDEN is set to 1.
+  namespace golden
+  {
+    /// Internal buffer of display
+    std::vector<uint8_t> Buffer_Image(const SSD1306 &display);
+
+    /// What emulated panel shows (testing::ssd1306::panel)
+    std::vector<uint8_t> Panel_Image(void);
+
+    /// Converts image to plain PBM (P1), one text line per row
+    std::string To_Plain_Pbm(const std::vector<uint8_t> &image);
+
+    /// Reads PBM (P1 or P4) of size 128x64
+    /// @retval False if text is not such image.
+    bool From_Pbm(const std::string &pbm, std::vector<uint8_t> &image);
+
+    /// @retval Empty string if images are equal, otherwise report with number of different pixels,
+    /// their bounding box and map of it ('#' lit in both, '+' lit only in image, '-' lit only in golden).
+    std::string Diff(const std::vector<uint8_t> &image, const std::vector<uint8_t> &golden);
+
+    /// Compares image with golden \a name (see testing::golden::Diff). On mismatch image is
+    /// written next to golden as name.actual.pbm.
+    std::string Compare(const std::string &name, const std::vector<uint8_t> &image);
+  }
+}
+
+#endif /* GOLDEN_HPP_ */
@@ -0,0 +1,92 @@
+/**
+ ******************************************************************************
+ * @file    mirror_view/mirror_view.cpp
+ * @author  agent
+ * @date    17.10.2026
+ * @brief   Host viewer of stream sent by SSD1306_Mirror
+ ******************************************************************************
+ * <h2><center>&copy; COPYRIGHT(c) 2026 agent
+ * </center></h2>
+ *
+ *Permission is hereby granted, free of charge,
+ *to any person obtaining a copy of this software and associated documentation files
+ *(the "Software"), to deal in the Software without restriction,
+ *including without limitation the rights to use, copy, modify,
+ *merge, publish, distribute, sublicense, and/or sell copies of
+ *the Software, and to permit persons to whom the Software is furnished to do so,
+ *subject to the following conditions:
+ *
+ *The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ *THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ *INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ *PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ *FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************************************
+ *
+ * Reads stream written by SSD1306_Mirror from standard input (e.g. serial port or socket) and
+ * writes every received frame as PBM image. Build on host (from repository root):
+ *
+ *   g++ -std=c++14 -IInc -ITests/fakes Src/SSD1306_mirror_decoder.cpp Src/SSD1306_snapshot.cpp \
+ *       Tests/mirror_view/mirror_view.cpp -o mirror_view
+ *
+ * Usage:
+ *
+ *   mirror_view frame_ < /dev/ttyUSB0      writes frame_000001.pbm, frame_000002.pbm...
+ *   nc device 5000 | mirror_view - | ffplay -f image2pipe -vcodec pbm -      shows live view
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <unistd.h>
+#include "SSD1306_mirror.hpp"
+#include "SSD1306_snapshot.hpp"
+
+namespace
+{
+  SSD1306_Mirror::Decoder decoder;
+  uint8_t input[4096];
+  uint8_t pbm[SSD1306_Snapshot::pbm_size];
+
+  bool Write_Frame(const char *prefix, uint32_t number)
+  {
+    const uint16_t size = SSD1306_Snapshot::Encode_Pbm(decoder.Image(), pbm);
+    if (prefix[0] == '-' && prefix[1] == '\0')
+      {
+        return fwrite(pbm, 1, size, stdout) == size && fflush(stdout) == 0;
+      }
+    char name[256];
+    snprintf(name, sizeof(name), "%s%06u.pbm", prefix, unsigned(number));
+    FILE *file = fopen(name, "wb");
+    if (file == nullptr)
+      {
+        return false;
+      }
+    bool ok = fwrite(pbm, 1, size, file) == size;
+    return fclose(file) == 0 && ok;
+  }
+}
+
+int main(int argc, char **argv)
+{
+  const char *prefix = argc > 1 ? argv[1] : "frame_";
+  uint32_t frames = 0;
+  ssize_t got;
+  while ((got = read(0, input, sizeof(input))) > 0)
+    {
+      for (ssize_t i = 0; i < got; i++)
+        {
+          if (decoder.Feed(input[i]) && !Write_Frame(prefix, ++frames))
+            {
+              fprintf(stderr, "mirror_view: cannot write frame %u\n", unsigned(frames));
+              return 1;
+            }
+        }
+    }
+  fprintf(stderr, "mirror_view: %u frames, %u bad or lost packets\n", unsigned(frames),
+      unsigned(decoder.Get_Errors()));
+  return 0;
+}
@@ -0,0 +1,367 @@
+/**
+ ******************************************************************************
+ * @file    reference.cpp
+ * @author  agent
+ * @date    17.10.2026
+ * @brief   Pixel by pixel reference implementation of drawing functions
+ ******************************************************************************
+ * <h2><center>&copy; COPYRIGHT(c) 2026 agent
+ * </center></h2>
+ *
+ *Permission is hereby granted, free of charge,
+ *to any person obtaining a copy of this software and associated documentation files
+ *(the "Software"), to deal in the Software without restriction,
+ *including without limitation the rights to use, copy, modify,
+ *merge, publish, distribute, sublicense, and/or sell copies of
+ *the Software, and to permit persons to whom the Software is furnished to do so,
+ *subject to the following conditions:
+ *
+ *The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ *THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ *INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ *PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ *FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************************************
+ */
+
+#include "reference.hpp"
+
+namespace testing
+{
+  Reference_Canvas::Reference_Canvas(uint8_t height) :
+      height(height)
+  {
+    Fill(SSD1306::Color::BLACK);
+  }
+
+  void Reference_Canvas::Fill(SSD1306::Color c)
+  {
+    for (int y = 0; y < 64; y++)
+      {
+        for (int x = 0; x < width; x++)
+          {
+            // buffer has 64 rows also for lower displays
+            pixels[y][x] = c == SSD1306::Color::INVERT ? !pixels[y][x] : c == SSD1306::Color::WHITE;
+          }
+      }
+  }
+
+  void Reference_Canvas::Fill_Pattern(uint32_t pattern)
+  {
+    for (int y = 0; y < 64; y++)
+      {
+        for (int x = 0; x < width; x++)
+          {
+            pixels[y][x] = (pattern >> (8 * (x % 4) + y % 8)) & 1;
+          }
+      }
+  }
+
+  void Reference_Canvas::Draw_Pixel(int x, int y, SSD1306::Color c)
+  {
+    if (x < 0 || y < 0 || x >= width || y >= height)
+      {
+        return;
+      }
+    pixels[y][x] = c == SSD1306::Color::INVERT ? !pixels[y][x] : c == SSD1306::Color::WHITE;
+  }
+
+  void Reference_Canvas::Draw_Line_H(uint8_t x, uint8_t y, uint8_t width, SSD1306::Color c)
+  {
+    for (int i = 0; i < width; i++)
+      {
+        Draw_Pixel(x + i, y, c);
+      }
+  }
+
+  void Reference_Canvas::Draw_Line_V(uint8_t x, uint8_t y, uint8_t height, SSD1306::Color c)
+  {
+    for (int i = 0; i < height; i++)
+      {
+        Draw_Pixel(x, y + i, c);
+      }
+  }
+
+  void Reference_Canvas::Draw_Square(uint8_t x, uint8_t y, uint8_t x2, uint8_t y2, SSD1306::Color c)
+  {
+    const int left = x < x2 ? x : x2;
+    const int right = x < x2 ? x2 : x;
+    const int top = y < y2 ? y : y2;
+    const int bottom = y < y2 ? y2 : y;
+    for (int row = top; row <= bottom; row++)
+      {
+        for (int column = left; column <= right; column++)
+          {
+            if (row == top || row == bottom || column == left || column == right)
+              {
+                Draw_Pixel(column, row, c);
+              }
+          }
+      }
+  }
+
+  void Reference_Canvas::Draw_Waveform(uint8_t x, uint8_t y, const uint8_t *values, uint8_t size,
+      SSD1306::Color c)
+  {
+    for (int i = 0; i < size; i++)
+      {
+        Draw_Pixel(x + i, y - values[i], c);
+      }
+  }
+
+  void Reference_Canvas::Fill_Rectangle(uint8_t x, uint8_t y, uint8_t width, uint8_t height, SSD1306::Color c)
+  {
+    for (int row = y; row < y + height; row++)
+      {
+        for (int column = x; column < x + width; column++)
+          {
+            Draw_Pixel(column, row, c);
+          }
+      }
+  }
+
+  void Reference_Canvas::Fill_Rectangle(uint8_t x, uint8_t y, uint8_t width, uint8_t height,
+      const Patterns::PatternDef &pattern)
+  {
+    for (int row = y; row < y + height; row++)
+      {
+        for (int column = x; column < x + width; column++)
+          {
+            Draw_Pattern_Pixel(column, row, pattern);
+          }
+      }
+  }
+
+  void Reference_Canvas::Invert_Region(uint8_t x, uint8_t y, uint8_t width, uint8_t height)
+  {
+    Fill_Rectangle(x, y, width, height, SSD1306::Color::INVERT);
+  }
+
+  void Reference_Canvas::Copy_Region(uint8_t x, uint8_t y, uint8_t width, uint8_t height, int16_t to_x,
+      int16_t to_y)
+  {
+    // source is clipped to display, then copied through temporary canvas so it can overlap destination
+    const Reference_Canvas source = *this;
+    for (int row = 0; row < height && y + row < this->height; row++)
+      {
+        for (int column = 0; column < width && x + column < this->width; column++)
+          {
+            Draw_Pixel(to_x + column, to_y + row,
+                source.Pixel(x + column, y + row) ? SSD1306::Color::WHITE : SSD1306::Color::BLACK);
+          }
+      }
+  }
+
+  void Reference_Canvas::Fill_Circle(uint8_t x, uint8_t y, uint8_t radius, SSD1306::Color c)
+  {
+    for (int row = y - radius; row <= y + radius; row++)
+      {
+        for (int column = x - radius; column <= x + radius; column++)
+          {
+            if ((column - x) * (column - x) + (row - y) * (row - y) <= radius * radius)
+              {
+                Draw_Pixel(column, row, c);
+              }
+          }
+      }
+  }
+
+  void Reference_Canvas::Fill_Circle(uint8_t x, uint8_t y, uint8_t radius, const Patterns::PatternDef &pattern)
+  {
+    for (int row = y - radius; row <= y + radius; row++)
+      {
+        for (int column = x - radius; column <= x + radius; column++)
+          {
+            if ((column - x) * (column - x) + (row - y) * (row - y) <= radius * radius)
+              {
+                Draw_Pattern_Pixel(column, row, pattern);
+              }
+          }
+      }
+  }
+
+  void Reference_Canvas::Fill_Polygon(const SSD1306::Point *points, uint8_t count, SSD1306::Color c)
+  {
+    if (count < 3 || count > SSD1306_POLYGON_MAX_POINTS)
+      {
+        return;
+      }
+    for (int y = 0; y < height; y++)
+      {
+        for (int x = 0; x < width; x++)
+          {
+            if (Inside_Polygon(points, count, x, y))
+              {
+                Draw_Pixel(x, y, c);
+              }
+          }
+      }
+  }
+
+  void Reference_Canvas::Fill_Polygon(const SSD1306::Point *points, uint8_t count,
+      const Patterns::PatternDef &pattern)
+  {
+    if (count < 3 || count > SSD1306_POLYGON_MAX_POINTS)
+      {
+        return;
+      }
+    for (int y = 0; y < height; y++)
+      {
+        for (int x = 0; x < width; x++)
+          {
+            if (Inside_Polygon(points, count, x, y))
+              {
+                Draw_Pattern_Pixel(x, y, pattern);
+              }
+          }
+      }
+  }
+
+  bool Reference_Canvas::Inside_Polygon(const SSD1306::Point *points, uint8_t count, int x, int y)
+  {
+    bool inside = false;
+    for (uint8_t i = 0; i < count; i++)
+      {
+        const SSD1306::Point &a = points[i];
+        const SSD1306::Point &b = points[(i + 1) % count];
+        if ((a.x <= x && b.x > x) || (b.x <= x && a.x > x))
+          {
+            // crossing of edge with vertical line through center of column, in 1/256 of pixel
+            const int64_t crossing = a.y * 256 + (int64_t(2 * (x - a.x) + 1) * (b.y - a.y) * 256) / (2 * (b.x - a.x));
+            if (crossing <= y * 256 + 128)
+              {
+                inside = !inside;
+              }
+          }
+      }
+    return inside;
+  }
+
+  void Reference_Canvas::Draw_Image(const uint8_t *image)
+  {
+    for (int y = 0; y < 64; y++)
+      {
+        for (int x = 0; x < width; x++)
+          {
+            pixels[y][x] = (image[(y / 8) * width + x] >> (y % 8)) & 1;
+          }
+      }
+  }
+
+  void Reference_Canvas::Draw_Image_Region(const uint8_t *image, uint8_t x, uint8_t y, uint8_t width,
+      uint8_t height)
+  {
+    for (int row = y; row < y + height; row++)
+      {
+        for (int column = x; column < x + width; column++)
+          {
+            if (column < this->width && row < this->height)
+              {
+                pixels[row][column] = (image[(row / 8) * this->width + column] >> (row % 8)) & 1;
+              }
+          }
+      }
+  }
+
+  void Reference_Canvas::Draw_Pattern_Pixel(int x, int y, const Patterns::PatternDef &pattern)
+  {
+    if (x < 0 || y < 0)
+      {
+        return;
+      }
+    const bool lit = (pattern.Columns[x % 8] >> (y % 8)) & 1;
+    Draw_Pixel(x, y, lit ? SSD1306::Color::WHITE : SSD1306::Color::BLACK);
+  }
+
+  void Reference_Canvas::Set_Font_size(Fonts::FontDef font)
+  {
+    this->font = font;
+  }
+
+  void Reference_Canvas::Set_Cursor(uint8_t x, uint8_t y)
+  {
+    cursor_x = x < width ? x : width;
+    cursor_y = y < height ? y : height;
+  }
+
+  void Reference_Canvas::Write_String(const char *str)
+  {
+    for (; *str != '\0'; str++)
+      {
+        Write_Char(*str, false);
+      }
+  }
+
+  void Reference_Canvas::Write_String_Inverted(const char *str)
+  {
+    for (; *str != '\0'; str++)
+      {
+        Write_Char(*str, true);
+      }
+  }
+
+  void Reference_Canvas::Write_Char(char chr, bool inverted)
+  {
+    const unsigned char code = (chr < ' ' || chr > '~') ? '?' : chr;
+    for (int row = 0; row < font.FontHeight; row++)
+      {
+        const uint16_t bits = font.data[(code - ' ') * font.FontHeight + row];
+        for (int column = 0; column < font.FontWidth; column++)
+          {
+            const bool lit = (bits >> (15 - column)) & 1;
+            Draw_Pixel(cursor_x + column, cursor_y + row,
+                lit != inverted ? SSD1306::Color::WHITE : SSD1306::Color::BLACK);
+          }
+      }
+    cursor_x = cursor_x + font.FontWidth < width ? cursor_x + font.FontWidth : width;
+  }
+
+  bool Reference_Canvas::Pixel(int x, int y) const
+  {
+    return x >= 0 && y >= 0 && x < width && y < 64 && pixels[y][x];
+  }
+
+  std::vector<uint8_t> Reference_Canvas::Image(void) const
+  {
+    std::vector<uint8_t> image(width * 64 / 8, 0);
+    for (int y = 0; y < 64; y++)
+      {
+        for (int x = 0; x < width; x++)
+          {
+            if (pixels[y][x])
+              {
+                image[(y / 8) * width + x] |= uint8_t(1 << (y % 8));
+              }
+          }
+      }
+    return image;
+  }
+
+  std::string Reference_Canvas::Compare(const uint8_t *image) const
+  {
+    int different = 0;
+    int first_x = 0, first_y = 0;
+    for (int y = 0; y < 64; y++)
+      {
+        for (int x = 0; x < width; x++)
+          {
+            const bool lit = (image[(y / 8) * width + x] >> (y % 8)) & 1;
+            if (lit != bool(pixels[y][x]) && different++ == 0)
+              {
+                first_x = x;
+                first_y = y;
+              }
+          }
+      }
+    if (different == 0)
+      {
+        return "";
+      }
+    return std::to_string(different) + " pixels differ from reference, first at x=" + std::to_string(first_x)
+        + " y=" + std::to_string(first_y);
+  }
+}
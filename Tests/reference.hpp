@@ -0,0 +1,98 @@
+/**
+ ******************************************************************************
+ * @file    reference.hpp
+ * @author  agent
+ * @date    17.10.2026
+ * @brief   Pixel by pixel reference implementation of drawing functions
+ ******************************************************************************
+ * <h2><center>&copy; COPYRIGHT(c) 2026 agent
+ * </center></h2>
+ *
+ *Permission is hereby granted, free of charge,
+ *to any person obtaining a copy of this software and associated documentation files
+ *(the "Software"), to deal in the Software without restriction,
+ *including without limitation the rights to use, copy, modify,
+ *merge, publish, distribute, sublicense, and/or sell copies of
+ *the Software, and to permit persons to whom the Software is furnished to do so,
+ *subject to the following conditions:
+ *
+ *The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ *THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ *INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ *PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ *FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************************************
+ */
+
+#ifndef REFERENCE_HPP_
+#define REFERENCE_HPP_
+
+#include <stdint.h>
+#include <array>
+#include <string>
+#include <vector>
+#include "SSD1306.hpp"
+
+namespace testing
+{
+  /// Deliberately simple model of SSD1306 drawing functions used as oracle for optimized ones:
+  /// one byte per pixel, every primitive is written straight from its definition with int coordinates
+  /// and each pixel is clipped separately. Functions have the same names and parameters as in SSD1306.
+  class Reference_Canvas
+  {
+  public:
+    explicit Reference_Canvas(uint8_t height = 64);
+
+    void Fill(SSD1306::Color c);
+    void Fill_Pattern(uint32_t pattern);
+    void Draw_Pixel(int x, int y, SSD1306::Color c);
+    void Draw_Line_H(uint8_t x, uint8_t y, uint8_t width, SSD1306::Color c);
+    void Draw_Line_V(uint8_t x, uint8_t y, uint8_t height, SSD1306::Color c);
+    void Draw_Square(uint8_t x, uint8_t y, uint8_t x2, uint8_t y2, SSD1306::Color c);
+    void Draw_Waveform(uint8_t x, uint8_t y, const uint8_t *values, uint8_t size, SSD1306::Color c);
+    void Fill_Rectangle(uint8_t x, uint8_t y, uint8_t width, uint8_t height, SSD1306::Color c);
+    void Fill_Rectangle(uint8_t x, uint8_t y, uint8_t width, uint8_t height, const Patterns::PatternDef &pattern);
+    void Invert_Region(uint8_t x, uint8_t y, uint8_t width, uint8_t height);
+    void Copy_Region(uint8_t x, uint8_t y, uint8_t width, uint8_t height, int16_t to_x, int16_t to_y);
+    void Fill_Circle(uint8_t x, uint8_t y, uint8_t radius, SSD1306::Color c);
+    void Fill_Circle(uint8_t x, uint8_t y, uint8_t radius, const Patterns::PatternDef &pattern);
+    void Fill_Polygon(const SSD1306::Point *points, uint8_t count, SSD1306::Color c);
+    void Fill_Polygon(const SSD1306::Point *points, uint8_t count, const Patterns::PatternDef &pattern);
+    void Draw_Image(const uint8_t *image);
+    void Draw_Image_Region(const uint8_t *image, uint8_t x, uint8_t y, uint8_t width, uint8_t height);
+
+    void Set_Font_size(Fonts::FontDef font);
+    void Set_Cursor(uint8_t x, uint8_t y);
+    void Write_String(const char *str);
+    void Write_String_Inverted(const char *str);
+
+    bool Pixel(int x, int y) const;
+
+    /// Image in layout of SSD1306::Draw_Image, for comparison with SSD1306::Take_Snapshot
+    std::vector<uint8_t> Image(void) const;
+
+    /// Compares \a image (e.g. from SSD1306::Take_Snapshot) with reference
+    /// @retval Empty string if equal, otherwise number of different pixels and position of the first one
+    std::string Compare(const uint8_t *image) const;
+
+  private:
+    static const uint8_t width = 128;
+    uint8_t height;
+    std::array<std::array<uint8_t, width>, 64> pixels;
+    Fonts::FontDef font = Fonts::font_7x10;
+    int cursor_x = 0;
+    int cursor_y = 0;
+
+    void Write_Char(char chr, bool inverted);
+    /// Pixel of rectangle or shape filled with pattern, pattern is anchored at top left corner of display
+    void Draw_Pattern_Pixel(int x, int y, const Patterns::PatternDef &pattern);
+    /// Even-odd test of center of pixel, edges are crossed at column centers rounded to 1/256 of pixel
+    static bool Inside_Polygon(const SSD1306::Point *points, uint8_t count, int x, int y);
+  };
+}
+
+#endif /* REFERENCE_HPP_ */
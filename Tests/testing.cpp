@@ -30,11 +30,24 @@
 
 
 #include "testing.hpp"
+#include "SSD1306.hpp"
 
 namespace testing
 {
     namespace ssd1306
     {
       std::vector<uint8_t>  data;
+      int transfers_pending = 0;
+      uint32_t bytes_delivered = 0;
+      uint32_t nack_at_byte = 0;
+      uint32_t nack_times = 0;
+      int nack_error = SSD1306::ERROR_NACK;
+
+      void Inject_Nack(uint32_t byte, uint32_t times)
+      {
+        bytes_delivered = 0;
+        nack_at_byte = byte;
+        nack_times = times;
+      }
     }
 }
@@ -39,6 +39,16 @@ namespace testing
   namespace ssd1306
   {
     extern std::vector<uint8_t>  data;
+    extern int transfers_pending; ///< non-blocking transfers started and not completed yet
+
+    // fault injection
+    extern uint32_t bytes_delivered; ///< bytes acknowledged by fake display
+    extern uint32_t nack_at_byte; ///< value of bytes_delivered at which byte is not acknowledged
+    extern uint32_t nack_times; ///< number of transfers which will fail at nack_at_byte
+    extern int nack_error; ///< error set by failed transfer
+
+    /// Transfer containing byte \a byte (counted from now) fails \a times times
+    void Inject_Nack(uint32_t byte, uint32_t times = 1);
   }
 }
 